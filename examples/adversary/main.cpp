@@ -0,0 +1,177 @@
+/**
+ * @file main.cpp
+ * @brief ステップマップの更新の計算量が最大となる迷路を局所探索で求める例
+ * @details
+ * - 生成した迷路を初期解とし、壁を少しずつ変えて評価値が下がらなければ採用する
+ * - 評価値は StepMap::getCounters() の計数 (緩和の回数またはキューの最大長)
+ * - 探索走行 (search) では、探索途中と同じく未知壁を壁なしとした迷路を
+ *   未知壁は通過可能として評価し、
+ *   最短走行 (shortest) では全既知の迷路を台形加速を考慮して評価する
+ * - 得られた最悪の迷路を *.maze 形式で保存し、回帰用のベンチマークとする。
+ *   探索走行では、既知壁を壁ログ (*.maze.known) としても保存する。
+ *   Maze::restoreWallRecordsFromFile() で探索途中の迷路を復元できる
+ *
+ * ```sh
+ * ./example_adversary [size] [search|shortest] [relaxations|queue] \
+ *                     [iterations] [seed] [output]
+ * ```
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+
+/*
+ * 標準ライブラリの読み込み
+ */
+#include <algorithm>  //< for std::min, std::max
+#include <chrono>     //< for std::chrono
+#include <cstdlib>    //< for std::atoi
+#include <random>     //< for std::mt19937
+
+/*
+ * 迷路ライブラリの読み込み
+ */
+#include "MazeLib/MazeGenerator.h"
+#include "MazeLib/StepMap.h"
+
+/* 計数が無効だとキューの最大長が常に 0 となり、評価値が意味をなさない */
+#if !MAZE_STEP_MAP_COUNTERS
+#error "example_adversary requires MAZE_STEP_MAP_COUNTERS=1"
+#endif
+
+/*
+ * 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 局所探索の設定
+ */
+struct Config {
+  int size = MAZE_SIZE;  /**< @brief 迷路の1辺の区画数 */
+  bool search = true;    /**< @brief true: 探索走行、false: 最短走行 */
+  bool queue = false;    /**< @brief true: キューの最大長を評価 */
+  int iterations = 2000; /**< @brief 反復回数 */
+  int seed = 0;          /**< @brief 乱数のシード値 */
+  std::string output;    /**< @brief 保存先のファイルパス */
+};
+
+/**
+ * @brief 迷路の評価値。ゴールに到達できない迷路は -1
+ */
+int Evaluate(const Config& config, const Maze& maze, StepMap& stepMap) {
+  /* 到達可能性の確認 */
+  stepMap.update(maze, maze.getGoals(), !config.search, true);
+  if (stepMap.getStep(maze.getStart()) == StepMap::STEP_MAX) return -1;
+  /* 対象の走行と同じ条件で更新 */
+  stepMap.update(maze, maze.getGoals(), !config.search, config.search);
+  const auto& c = stepMap.getCounters();
+  return config.queue ? c.queueSizeMax : c.relaxations;
+}
+
+/**
+ * @brief 壁をひとつ変化させる
+ * @details
+ * 壁の状態を、既知の壁あり、既知の壁なし、未知 (探索走行のみ) の間で変える。
+ * 未知壁は探索途中と同じく壁なしとする。
+ */
+void Mutate(const Config& config, Maze& maze, std::mt19937& mt) {
+  while (1) {
+    const auto x = mt() % config.size, y = mt() % config.size;
+    const auto d = Direction::Along4()[mt() % 4];
+    const auto p = Position(x, y), q = p.next(d);
+    if (q.x >= config.size || q.y >= config.size || !q.isInsideOfField())
+      continue;
+    /* スタート区画の壁は変えない */
+    if (p == maze.getStart() || q == maze.getStart()) continue;
+    /* 0: 未知, 1: 既知の壁なし, 2: 既知の壁あり */
+    const int state = !maze.isKnown(p, d) ? 0 : maze.isWall(p, d) ? 2 : 1;
+    const int next =
+        config.search ? (state + 1 + mt() % 2) % 3 : (state == 2 ? 1 : 2);
+    maze.setKnown(p, d, next != 0);
+    maze.setWall(p, d, next == 2);
+    return;
+  }
+}
+
+/**
+ * @brief 既知壁を壁ログとして保存する
+ * @details Maze::restoreWallRecordsFromFile() で既知壁と未知壁を復元できる
+ */
+bool SaveKnownWalls(const Maze& maze, const std::string& filepath) {
+  Maze known;
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (wi.isInsideOfField() && maze.isKnown(wi))
+      known.updateWall(wi.getPosition(), wi.getDirection(), maze.isWall(wi));
+  }
+  return known.backupWallRecordsToFile(filepath, true);
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char* argv[]) {
+  Config config;
+  /* スタート区画以外の壁を変えられるよう、2区画以上とする */
+  if (argc > 1)
+    config.size = std::max(2, std::min(std::atoi(argv[1]), MAZE_SIZE));
+  if (argc > 2) config.search = std::string(argv[2]) != "shortest";
+  if (argc > 3) config.queue = std::string(argv[3]) == "queue";
+  if (argc > 4) config.iterations = std::atoi(argv[4]);
+  if (argc > 5) config.seed = std::atoi(argv[5]);
+  config.output = argc > 6 ? argv[6]
+                           : std::string("worst-") +
+                                 (config.search ? "search" : "shortest") +
+                                 "-" + (config.queue ? "queue" : "relax") +
+                                 "-" + std::to_string(config.size) + ".maze";
+  /* 初期解 */
+  std::mt19937 mt(config.seed);
+  StepMap stepMap;
+  auto best = MazeGenerator(config.seed)
+                  .generate(MazeGenerator::Braided, config.size);
+  int bestScore = Evaluate(config, best, stepMap);
+  const int initialScore = bestScore;
+  /* 局所探索; 評価値が下がらなければ採用する (平坦な移動を許す) */
+  for (int i = 0; i < config.iterations; ++i) {
+    auto candidate = best;
+    const int flips = 1 + mt() % 3;
+    for (int j = 0; j < flips; ++j) Mutate(config, candidate, mt);
+    const int score = Evaluate(config, candidate, stepMap);
+    if (score < bestScore) continue;
+    if (score > bestScore)
+      std::cout << "iteration " << i << ": " << score << std::endl;
+    best = candidate;
+    bestScore = score;
+  }
+  /* 結果の表示 */
+  best.print(std::cout, config.size);
+  Evaluate(config, best, stepMap);
+  const auto c = stepMap.getCounters();
+  const int n = 100;
+  const auto t_s = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; ++i)
+    stepMap.update(best, best.getGoals(), !config.search, config.search);
+  const auto t_e = std::chrono::steady_clock::now();
+  const auto us = std::chrono::duration<float, std::micro>(t_e - t_s).count();
+  std::cout << "score:\t" << initialScore << " -> " << bestScore << std::endl;
+  std::cout << "pops:\t" << c.pops << std::endl;
+  std::cout << "relax:\t" << c.relaxations << std::endl;
+  std::cout << "queue:\t" << c.queueSizeMax << std::endl;
+  std::cout << "update:\t" << us / n << " [us]" << std::endl;
+  /* 回帰用のベンチマークとして保存 */
+  if (!MazeGenerator::save(best, config.output, config.size)) {
+    std::cerr << "Failed to Save Maze: " << config.output << std::endl;
+    return -1;
+  }
+  std::cout << "saved:\t" << config.output << std::endl;
+  if (config.search) {
+    const auto knownOutput = config.output + ".known";
+    if (!SaveKnownWalls(best, knownOutput)) {
+      std::cerr << "Failed to Save Known Walls: " << knownOutput << std::endl;
+      return -1;
+    }
+    std::cout << "saved:\t" << knownOutput << std::endl;
+  }
+  return 0;
+}
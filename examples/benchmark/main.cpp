@@ -0,0 +1,227 @@
+/**
+ * @file main.cpp
+ * @brief 生成した迷路で、迷路の大きさと形状に対する計算時間を測る例
+ * @details
+ * - 形状と大きさごとに、シード値を変えた迷路を生成する
+ * - 全既知の迷路でのステップマップの更新時間を測る
+ * - 足立法でゴールまで探索走行し、走行区画数と経路計画の合計時間を測る
+ * - 出力先のディレクトリを指定すると、生成した迷路を *.maze 形式で保存する
+ * - 探索途中と全既知の迷路で、DualStepMap による2種類のステップの更新と
+ *   StepMap の2回の更新 (knownOnly=true, false) の計算時間を比べる
+ * - BatchPlanner で全区画からゴールへの経路をまとめて導出し、
+ *   スレッド数ごとの計算時間と1スレッドに対する速度比を測る
+ *
+ * ```sh
+ * ./example_benchmark [seeds] [output-directory]
+ * ```
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+
+/*
+ * 標準ライブラリの読み込み
+ */
+#include <algorithm>  //< for std::max
+#include <chrono>     //< for std::chrono
+#include <cstdlib>    //< for std::atoi
+#include <functional>  //< for std::function
+#include <iomanip>    //< for std::setw
+#include <thread>     //< for std::thread::hardware_concurrency
+
+/*
+ * 迷路ライブラリの読み込み
+ */
+#include "MazeLib/BatchPlanner.h"
+#include "MazeLib/DualStepMap.h"
+#include "MazeLib/MazeGenerator.h"
+#include "MazeLib/StepMap.h"
+
+/*
+ * 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 関数の実行時間 [us] を返す
+ */
+template <typename F>
+float MeasureMicroseconds(F&& f) {
+  const auto t_s = std::chrono::steady_clock::now();
+  f();
+  const auto t_e = std::chrono::steady_clock::now();
+  return std::chrono::duration<float, std::micro>(t_e - t_s).count();
+}
+
+/**
+ * @brief 足立法でゴールまで探索走行する
+ * @param[out] planUs 経路計画の合計時間 [us]
+ * @param[in] onPlan 経路計画の直前に探索途中の迷路を渡す関数 (省略可)
+ * @return 走行区画数。失敗した場合は -1
+ */
+int SearchRun(const Maze& mazeTarget, float& planUs,
+              const std::function<void(const Maze&)>& onPlan = nullptr) {
+  StepMap stepMap;
+  Maze maze(mazeTarget.getGoals(), mazeTarget.getStart());
+  Position currentPos = maze.getStart();
+  int count = 0;
+  planUs = 0;
+  while (1) {
+    /* 現在区画の壁を確認 */
+    for (const auto d : Direction::Along4())
+      maze.updateWall(currentPos, d, mazeTarget.isWall(currentPos, d));
+    /* 現在地のゴール判定 */
+    const auto& goals = maze.getGoalSet();
+    if (goals.contains(currentPos))
+      return count;
+    /* 未知壁はないものとしてゴールへ向かう */
+    if (onPlan) onPlan(maze);
+    Directions moveDirs;
+    planUs += MeasureMicroseconds([&] {
+      moveDirs = stepMap.calcShortestDirections(maze, currentPos, goals,
+                                                false, true);
+    });
+    if (moveDirs.empty()) return -1;
+    /* 未知壁のある区画まで進む */
+    for (const auto nextDir : moveDirs) {
+      currentPos = currentPos.next(nextDir);
+      ++count;
+      if (maze.unknownCount(currentPos)) break;
+    }
+  }
+}
+
+/**
+ * @brief 2種類のステップの更新時間を表示する
+ * @details DualStepMap::update() と StepMap::update() 2回の時間を比べる。
+ * - search: 探索走行の経路計画ごとに、探索途中の迷路で測った合計
+ * - known: 全既知の迷路 (最短経路の確定判定の時点) で測った値
+ */
+void BenchmarkDual(const int seeds) {
+  std::cout << std::setw(12) << "topology" << std::setw(8) << "simple"
+            << std::setw(14) << "search dual" << std::setw(8) << "twice"
+            << std::setw(8) << "ratio" << std::setw(14) << "known dual"
+            << std::setw(8) << "twice" << std::setw(8) << "ratio" << std::endl;
+  StepMap stepMap;
+  DualStepMap dual;
+  float dualUs, twiceUs;
+  const auto measure = [&](const Maze& m, const bool simple) {
+    const auto& goals = m.getGoalSet();
+    dualUs += MeasureMicroseconds([&] { dual.update(m, goals, simple); });
+    twiceUs += MeasureMicroseconds([&] {
+      stepMap.update(m, goals, true, simple);
+      stepMap.update(m, goals, false, simple);
+    });
+  };
+  for (int t = 0; t < MazeGenerator::TopologyMax; ++t) {
+    const auto topology = MazeGenerator::Topology(t);
+    for (const bool simple : {true, false}) {
+      std::cout << std::setw(12) << MazeGenerator::getName(topology)
+                << std::setw(8) << simple << std::fixed;
+      /* 探索途中の迷路 */
+      dualUs = twiceUs = 0;
+      for (int seed = 0; seed < seeds; ++seed) {
+        float us;
+        SearchRun(MazeGenerator(seed).generate(topology), us,
+                  [&](const Maze& m) { measure(m, simple); });
+      }
+      std::cout << std::setprecision(1) << std::setw(14) << dualUs / seeds
+                << std::setw(8) << twiceUs / seeds << std::setprecision(2)
+                << std::setw(8) << dualUs / twiceUs;
+      /* 全既知の迷路 */
+      dualUs = twiceUs = 0;
+      for (int seed = 0; seed < seeds; ++seed)
+        measure(MazeGenerator(seed).generate(topology), simple);
+      std::cout << std::setprecision(1) << std::setw(14) << dualUs / seeds
+                << std::setw(8) << twiceUs / seeds << std::setprecision(2)
+                << std::setw(8) << dualUs / twiceUs << std::endl;
+    }
+  }
+}
+
+/**
+ * @brief スレッド数ごとの BatchPlanner の計算時間を表示する
+ * @details 全既知の迷路で、全区画からゴールへの最短経路を
+ * まとめて導出する時間を、スレッド数を倍にしながら測る。
+ * @param repeats 計測の繰り返し回数
+ */
+void BenchmarkThreads(const int repeats) {
+  const auto maze = MazeGenerator(0).generate(MazeGenerator::Competition);
+  std::vector<BatchPlanner::Query> queries;
+  for (int i = 0; i < Position::SIZE; ++i)
+    queries.push_back({Position::getPositionFromIndex(i), maze.getGoals()});
+  const int threadsMax =
+      std::max(1, int(std::thread::hardware_concurrency()));
+  std::cout << std::setw(12) << "threads" << std::setw(14) << "batch[us]"
+            << std::setw(14) << "speedup" << std::endl;
+  /* 1 から倍にしたスレッド数と CPU 数 */
+  std::vector<int> threadCounts;
+  for (int threads = 1; threads < threadsMax; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(threadsMax);
+  float batchUs1 = 0;
+  for (const int threads : threadCounts) {
+    ThreadPool pool(threads);
+    BatchPlanner planner(pool);
+    float batchUs = 0;
+    for (int i = 0; i < repeats; ++i)
+      batchUs += MeasureMicroseconds([&] {
+        planner.calcShortestDirections(maze, queries, true, false);
+      });
+    batchUs /= repeats;
+    if (threads == 1) batchUs1 = batchUs;
+    std::cout << std::setw(12) << threads << std::fixed
+              << std::setprecision(1) << std::setw(14) << batchUs
+              << std::setw(14) << batchUs1 / batchUs << std::endl;
+  }
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char* argv[]) {
+  const int seeds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 8;
+  const std::string outputDirectory = argc > 2 ? argv[2] : "";
+  /* 表の見出し */
+  std::cout << std::setw(12) << "topology" << std::setw(6) << "size"
+            << std::setw(14) << "update[us]" << std::setw(14) << "search[cell]"
+            << std::setw(14) << "plan[us]" << std::endl;
+  StepMap stepMap;
+  for (int t = 0; t < MazeGenerator::TopologyMax; ++t) {
+    const auto topology = MazeGenerator::Topology(t);
+    for (int size = 4; size <= MAZE_SIZE; size += 4) {
+      float updateUs = 0, planUs = 0;
+      int cells = 0;
+      for (int seed = 0; seed < seeds; ++seed) {
+        const auto maze = MazeGenerator(seed).generate(topology, size);
+        if (!outputDirectory.empty())
+          MazeGenerator::save(maze,
+                              outputDirectory + "/" +
+                                  MazeGenerator::getName(topology) +
+                                  std::to_string(size) + "-" +
+                                  std::to_string(seed) + ".maze",
+                              size);
+        /* 全既知の迷路でのステップマップの更新 */
+        updateUs += MeasureMicroseconds(
+            [&] { stepMap.update(maze, maze.getGoals(), true, false); });
+        /* 探索走行 */
+        float us;
+        const int count = SearchRun(maze, us);
+        if (count < 0) {
+          MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
+          continue;
+        }
+        cells += count;
+        planUs += us;
+      }
+      std::cout << std::setw(12) << MazeGenerator::getName(topology)
+                << std::setw(6) << size << std::fixed << std::setprecision(1)
+                << std::setw(14) << updateUs / seeds  //
+                << std::setw(14) << float(cells) / seeds
+                << std::setw(14) << planUs / seeds << std::endl;
+    }
+  }
+  BenchmarkDual(seeds);
+  BenchmarkThreads(seeds);
+  return 0;
+}
@@ -0,0 +1,389 @@
+/**
+ * @file main.cpp
+ * @brief 迷路と経路計画を複数のシミュレータで共有するローカルデーモンの例
+ * @details
+ * - 迷路をメモリ上に保持し、Unix ドメインソケットで要求を受け付ける
+ * - 接続ごとのスレッドが要求を受け取り、経路計画の要求は一箇所に集められる
+ * - 同時に届いた経路計画の要求は、まとめてスレッドプールで処理される
+ * - 通信プロトコルは protocol.h を参照
+ *
+ * ```sh
+ * ## デーモンとして起動
+ * ./example_daemon [socket]
+ * ## 動作確認用のクライアント (迷路を送り、経路計画の応答時間を測る)
+ * ./example_daemon client ../mazedata/data/16MM2018CX.maze [socket]
+ * ```
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+
+/*
+ * 標準ライブラリの読み込み
+ */
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>  //< for std::max, std::copy_n
+#include <chrono>
+#include <condition_variable>
+#include <csignal>  //< for std::signal
+#include <cstring>  //< for std::strncpy, std::memcpy
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+/*
+ * 迷路ライブラリの読み込み
+ */
+#include "./protocol.h"
+#include "MazeLib/Maze.h"
+#include "MazeLib/StepMap.h"
+#include "MazeLib/ThreadPool.h"
+
+/*
+ * 名前空間の展開
+ */
+using namespace MazeLib;
+using namespace MazeDaemon;
+
+/**
+ * @brief 指定したバイト数をすべて受信する
+ * @return true: 成功、false: 切断またはエラー
+ */
+static bool readAll(const int fd, void* buf, size_t size) {
+  auto p = static_cast<uint8_t*>(buf);
+  while (size) {
+    const auto n = ::read(fd, p, size);
+    if (n <= 0) return false;
+    p += n, size -= n;
+  }
+  return true;
+}
+/**
+ * @brief 指定したバイト数をすべて送信する
+ * @return true: 成功、false: 切断またはエラー
+ */
+static bool writeAll(const int fd, const void* buf, size_t size) {
+  auto p = static_cast<const uint8_t*>(buf);
+  while (size) {
+    const auto n = ::write(fd, p, size);
+    if (n <= 0) return false;
+    p += n, size -= n;
+  }
+  return true;
+}
+/**
+ * @brief 現在時刻 [us]
+ */
+static int64_t getMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+/**
+ * @brief Unix ドメインソケットのアドレスを生成する
+ */
+static sockaddr_un makeAddress(const std::string& path) {
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+/**
+ * @brief 値をバイト列に追記する
+ */
+template <typename T>
+static void append(std::vector<uint8_t>& buf, const T* data, const size_t n) {
+  const auto p = reinterpret_cast<const uint8_t*>(data);
+  buf.insert(buf.end(), p, p + n * sizeof(T));
+}
+
+/**
+ * @brief デーモンが保持する迷路ひとつ分の状態
+ */
+struct MazeSlot {
+  Maze maze;               /**< @brief 迷路 */
+  std::shared_mutex mutex; /**< @brief 更新は排他、経路計画は共有でロック */
+};
+
+/**
+ * @brief 経路計画の要求
+ */
+struct PlanJob {
+  MazeSlot* slot;                /**< @brief 対象の迷路 */
+  bool knownOnly;                /**< @brief 既知壁のみを使用する */
+  bool simple;                   /**< @brief 台形加速を考慮しない */
+  bool stepMapOnly;              /**< @brief ステップマップのみを返す */
+  Positions starts;              /**< @brief 始点区画の集合 */
+  std::vector<uint8_t> response; /**< @brief 応答ペイロード */
+  std::promise<void> done;       /**< @brief 処理の完了通知 */
+};
+
+/**
+ * @brief 同時に届いた経路計画の要求をまとめてスレッドプールで処理するクラス
+ * @details
+ * 要求ごとにステップマップを1回だけ更新し、各始点からはステップを下るだけで
+ * 経路を求める。処理中に届いた要求は、次の一括処理にまとめられる。
+ */
+class PlanBatcher {
+ public:
+  explicit PlanBatcher(ThreadPool& pool)
+      : pool(pool), stepMaps(pool.size()), thread([this] { run(); }) {}
+  ~PlanBatcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      terminated = true;
+    }
+    cv.notify_all();
+    thread.join();
+  }
+  /**
+   * @brief 要求を登録し、処理の完了を待つ
+   */
+  void process(PlanJob& job) {
+    auto done = job.done.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending.push_back(&job);
+    }
+    cv.notify_one();
+    done.wait();
+  }
+
+ private:
+  ThreadPool& pool;               /**< @brief スレッドプール */
+  std::vector<StepMap> stepMaps;  /**< @brief ワーカーごとのステップマップ */
+  std::mutex mutex;               /**< @brief pending の保護 */
+  std::condition_variable cv;     /**< @brief 要求の到着通知 */
+  std::vector<PlanJob*> pending;  /**< @brief 未処理の要求 */
+  bool terminated = false;        /**< @brief 終了要求 */
+  std::thread thread;             /**< @brief 一括処理のスレッド */
+
+  void run() {
+    std::vector<PlanJob*> jobs;
+    while (1) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return terminated || !pending.empty(); });
+        if (terminated) return;
+        jobs.swap(pending);
+      }
+      pool.parallelFor(jobs.size(), [&](const int worker, const int index) {
+        plan(*jobs[index], stepMaps[worker]);
+      });
+      for (auto job : jobs) job->done.set_value();
+      jobs.clear();
+    }
+  }
+  static void plan(PlanJob& job, StepMap& stepMap) {
+    std::shared_lock<std::shared_mutex> lock(job.slot->mutex);
+    const auto& maze = job.slot->maze;
+    stepMap.update(maze, maze.getGoals(), job.knownOnly, job.simple);
+    if (job.stepMapOnly) {
+      append(job.response, stepMap.getMapArray().data(), Position::SIZE);
+      return;
+    }
+    for (const auto start : job.starts) {
+      Pose end;
+      auto dirs = stepMap.getStepDownDirections(
+          maze, {start, Direction::Max}, end, job.knownOnly, job.simple, false);
+      if (stepMap.getStep(end.p) != 0) dirs.clear();  //< 経路なし
+      const uint16_t size = dirs.size();
+      append(job.response, &size, 1);
+      append(job.response, dirs.data(), dirs.size());
+    }
+  }
+};
+
+/**
+ * @brief 接続ひとつ分の要求を順に処理する
+ */
+static void serve(const int fd, std::vector<MazeSlot>& slots,
+                  PlanBatcher& batcher) {
+  RequestHeader req;
+  std::vector<uint16_t> data;
+  while (readAll(fd, &req, sizeof(req))) {
+    ResponseHeader res = {};
+    std::vector<uint8_t> payload;
+    /* 不正な要求はペイロードを読み飛ばせないので切断 */
+    if (req.slot >= slots.size() || req.count > COUNT_MAX) {
+      res.status = static_cast<uint8_t>(Status::BadRequest);
+      writeAll(fd, &res, sizeof(res));
+      break;
+    }
+    data.resize(req.count);
+    if (!readAll(fd, data.data(), data.size() * sizeof(data[0]))) break;
+    auto& slot = slots[req.slot];
+    Positions positions(data.size());
+    for (size_t i = 0; i < data.size(); ++i) positions[i].data = data[i];
+    switch (static_cast<RequestType>(req.type)) {
+      case RequestType::ResetMaze: {
+        std::unique_lock<std::shared_mutex> lock(slot.mutex);
+        slot.maze = Maze(positions);
+        break;
+      }
+      case RequestType::UpdateWalls: {
+        std::unique_lock<std::shared_mutex> lock(slot.mutex);
+        for (const auto d : data) {
+          WallRecord r;
+          r.data = d;
+          if (!slot.maze.updateWall(r.getPosition(), r.getDirection(), r.b))
+            res.status = static_cast<uint8_t>(Status::Conflict);
+        }
+        break;
+      }
+      case RequestType::Plan:
+      case RequestType::GetStepMap: {
+        PlanJob job;
+        job.slot = &slot;
+        job.knownOnly = req.knownOnly;
+        job.simple = req.simple;
+        job.stepMapOnly = req.type == uint8_t(RequestType::GetStepMap);
+        job.starts = std::move(positions);
+        batcher.process(job);
+        payload = std::move(job.response);
+        break;
+      }
+      default:
+        res.status = static_cast<uint8_t>(Status::BadRequest);
+        break;
+    }
+    res.size = payload.size();
+    if (!writeAll(fd, &res, sizeof(res)) ||
+        !writeAll(fd, payload.data(), payload.size()))
+      break;
+  }
+  ::close(fd);
+}
+
+/**
+ * @brief デーモンとして要求を待ち受ける
+ */
+static int runDaemon(const std::string& path) {
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  const auto addr = makeAddress(path);
+  ::unlink(path.c_str());
+  if (fd < 0 ||
+      ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) ||
+      ::listen(fd, 64)) {
+    std::perror("failed to listen");
+    return -1;
+  }
+  ThreadPool pool;
+  PlanBatcher batcher(pool);
+  std::vector<MazeSlot> slots(MAZE_SLOTS);
+  std::cout << "listening on " << path << " with " << pool.size()
+            << " workers" << std::endl;
+  while (1) {
+    const int client = ::accept(fd, nullptr, nullptr);
+    if (client < 0) continue;
+    std::thread([=, &slots, &batcher] { serve(client, slots, batcher); })
+        .detach();
+  }
+  return 0;
+}
+
+/**
+ * @brief 要求を送り、応答を受け取る
+ * @return true: 成功、false: 切断、エラーまたは Status::Ok 以外の応答
+ */
+static bool request(const int fd, const RequestType type, const uint8_t slot,
+                    const std::vector<uint16_t>& data, ResponseHeader& res,
+                    std::vector<uint8_t>& payload, const bool knownOnly = false,
+                    const bool simple = false) {
+  const RequestHeader req = {static_cast<uint8_t>(type), slot, knownOnly,
+                             simple, static_cast<uint32_t>(data.size())};
+  if (!writeAll(fd, &req, sizeof(req)) ||
+      !writeAll(fd, data.data(), data.size() * sizeof(data[0])) ||
+      !readAll(fd, &res, sizeof(res)))
+    return false;
+  payload.resize(res.size);
+  if (!readAll(fd, payload.data(), payload.size())) return false;
+  if (res.status != static_cast<uint8_t>(Status::Ok)) {
+    std::cerr << "Request Failed: status " << +res.status << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 動作確認用のクライアント
+ * @details 迷路ファイルの壁をすべて送り、経路計画の応答時間を測る。
+ */
+static int runClient(const std::string& filepath, const std::string& path) {
+  Maze mazeTarget;
+  if (!mazeTarget.parse(filepath)) {
+    std::cerr << "Failed to Parse Maze: " << filepath << std::endl;
+    return -1;
+  }
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  const auto addr = makeAddress(path);
+  if (fd < 0 ||
+      ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr))) {
+    std::perror("failed to connect");
+    return -1;
+  }
+  ResponseHeader res;
+  std::vector<uint8_t> payload;
+  /* 迷路の初期化と壁の送信 */
+  std::vector<uint16_t> goals, walls;
+  for (const auto p : mazeTarget.getGoals()) goals.push_back(p.data);
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (wi.isInsideOfField())
+      walls.push_back(WallRecord(wi.getPosition(), wi.getDirection(),
+                                 mazeTarget.isWall(wi))
+                          .data);
+  }
+  if (!request(fd, RequestType::ResetMaze, 0, goals, res, payload) ||
+      !request(fd, RequestType::UpdateWalls, 0, walls, res, payload)) {
+    std::cerr << "Failed to Upload Maze" << std::endl;
+    return -1;
+  }
+  /* 経路計画の応答時間の計測 */
+  const int n = 1000;
+  const std::vector<uint16_t> starts = {mazeTarget.getStart().data};
+  const auto t0 = getMicroseconds();
+  int64_t tMax = 0;
+  for (int i = 0; i < n; ++i) {
+    const auto t = getMicroseconds();
+    if (!request(fd, RequestType::Plan, 0, starts, res, payload, true)) {
+      std::cerr << "Failed to Plan" << std::endl;
+      return -1;
+    }
+    tMax = std::max(tMax, getMicroseconds() - t);
+  }
+  const auto tAvg = (getMicroseconds() - t0) / n;
+  /* 結果の表示 (最初の始点の経路) */
+  uint16_t count = 0;
+  if (payload.size() >= sizeof(count))
+    std::memcpy(&count, payload.data(), sizeof(count));
+  if (payload.size() < sizeof(count) + count) {
+    std::cerr << "Invalid Plan Response" << std::endl;
+    return -1;
+  }
+  Directions dirs(count);
+  std::copy_n(payload.begin() + sizeof(count), count,
+              reinterpret_cast<uint8_t*>(dirs.data()));
+  mazeTarget.print(dirs, mazeTarget.getStart());
+  std::cout << "path length:\t" << dirs.size() << std::endl;
+  std::cout << "latency avg:\t" << tAvg << "\t[us]" << std::endl;
+  std::cout << "latency max:\t" << tMax << "\t[us]" << std::endl;
+  ::close(fd);
+  return 0;
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char* argv[]) {
+  /* 切断されたソケットへの書き込みで終了しないようにする */
+  std::signal(SIGPIPE, SIG_IGN);
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  if (args.size() >= 2 && args[0] == "client")
+    return runClient(args[1], args.size() >= 3 ? args[2] : DEFAULT_SOCKET_PATH);
+  return runDaemon(args.size() >= 1 ? args[0] : DEFAULT_SOCKET_PATH);
+}
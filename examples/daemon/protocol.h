@@ -0,0 +1,76 @@
+/**
+ * @file protocol.h
+ * @brief 経路計画デーモンの通信プロトコルの定義
+ * @details
+ * Unix ドメインソケット (SOCK_STREAM) 上で、要求ヘッダ + ペイロードを送り、
+ * 応答ヘッダ + ペイロードを受け取る。同一ホスト内の通信なので、
+ * すべての値はホストのバイトオーダーとする。
+ *
+ * | 要求        | 要求ペイロード                    | 応答ペイロード                          |
+ * | ----------- | --------------------------------- | --------------------------------------- |
+ * | ResetMaze   | ゴール区画 Position::data × count | なし                                    |
+ * | UpdateWalls | WallRecord::data × count          | なし                                    |
+ * | Plan        | 始点区画 Position::data × count   | (uint16 方向数 + 方向 int8 × 方向数) × count |
+ * | GetStepMap  | なし                              | ステップ uint16 × Position::SIZE        |
+ *
+ * - 経路計画の目的地は、その迷路のゴール区画の集合とする
+ * - 経路がない場合は方向数 0 とする
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace MazeDaemon {
+
+/** @brief 既定のソケットのパス */
+static constexpr const char* DEFAULT_SOCKET_PATH = "/tmp/mazelib.sock";
+/** @brief デーモンが保持する迷路の数 */
+static constexpr int MAZE_SLOTS = 16;
+/** @brief 1要求あたりの要素数の上限 */
+static constexpr uint32_t COUNT_MAX = 65536;
+
+/**
+ * @brief 要求の種類
+ */
+enum class RequestType : uint8_t {
+  ResetMaze,   /**< @brief 迷路を初期化し、ゴール区画を設定する */
+  UpdateWalls, /**< @brief 壁情報を更新する */
+  Plan,        /**< @brief 各始点からゴールへの最短経路を導出する */
+  GetStepMap,  /**< @brief ゴールを目的地とするステップマップを取得する */
+};
+
+/**
+ * @brief 応答の状態
+ */
+enum class Status : uint8_t {
+  Ok,         /**< @brief 正常 */
+  BadRequest, /**< @brief 要求の形式が不正 */
+  Conflict,   /**< @brief 既知の壁情報と矛盾する壁があった (他は更新済み) */
+};
+
+/**
+ * @brief 要求ヘッダ
+ */
+struct RequestHeader {
+  uint8_t type;      /**< @brief RequestType */
+  uint8_t slot;      /**< @brief 迷路の番号 (0 <= slot < MAZE_SLOTS) */
+  uint8_t knownOnly; /**< @brief 経路計画で既知壁のみを使用する */
+  uint8_t simple;    /**< @brief 経路計画で台形加速を考慮しない */
+  uint32_t count;    /**< @brief ペイロードの要素数 */
+};
+static_assert(sizeof(RequestHeader) == 8, "unexpected padding");
+
+/**
+ * @brief 応答ヘッダ
+ */
+struct ResponseHeader {
+  uint8_t status;      /**< @brief Status */
+  uint8_t reserved[3]; /**< @brief 予約 (0) */
+  uint32_t size;       /**< @brief ペイロードのバイト数 */
+};
+static_assert(sizeof(ResponseHeader) == 8, "unexpected padding");
+
+}  // namespace MazeDaemon
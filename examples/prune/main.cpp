@@ -0,0 +1,136 @@
+/**
+ * @file main.cpp
+ * @brief 最短経路に含まれ得ない区画の枝刈りの統計を迷路集について求める例
+ * @details
+ * - 各迷路について、足立法でゴールまで探索走行する
+ * - 走行中の各区画で枝刈りを行い、理由ごとの枝刈りした区画数を集計する
+ * - 探索後の迷路 (一部既知) と正解の迷路 (全既知) についても集計する
+ *
+ * ```sh
+ * ./example_prune ../mazedata/data/16MM2018CX.maze ../mazedata/data/*.maze
+ * ```
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+
+/*
+ * 標準ライブラリの読み込み
+ */
+#include <iomanip>  //< for std::setw
+
+/*
+ * 迷路ライブラリの読み込み
+ */
+#include "MazeLib/RegionPruner.h"
+
+/*
+ * 名前空間の展開
+ */
+using namespace MazeLib;
+
+/**
+ * @brief 統計を加算する
+ */
+void Accumulate(RegionPruner::Stats& sum, const RegionPruner::Stats& s) {
+  sum.unreachable += s.unreachable;
+  sum.deadEnd += s.deadEnd;
+  sum.articulation += s.articulation;
+  sum.detour += s.detour;
+}
+
+/**
+ * @brief 統計を1行で表示する
+ */
+void PrintStats(const std::string& name, const RegionPruner::Stats& s,
+                const int count) {
+  const auto avg = [&](const int v) { return count ? float(v) / count : 0; };
+  std::cout << std::setw(24) << name << std::fixed << std::setprecision(1)
+            << std::setw(10) << avg(s.unreachable)  //
+            << std::setw(10) << avg(s.deadEnd)      //
+            << std::setw(10) << avg(s.articulation) //
+            << std::setw(10) << avg(s.detour)       //
+            << std::setw(10) << avg(s.getTotal()) << std::endl;
+}
+
+/**
+ * @brief 足立法でゴールまで探索走行し、各区画での枝刈りの統計を集計する
+ * @return 枝刈りを行った回数
+ */
+int SearchRun(Maze& maze, const Maze& mazeTarget, RegionPruner::Stats& sum) {
+  StepMap stepMap;
+  RegionPruner pruner;
+  Position currentPos = maze.getStart();
+  int count = 0;
+  while (1) {
+    /* 現在区画の壁を確認 */
+    for (const auto d : Direction::Along4())
+      maze.updateWall(currentPos, d, mazeTarget.isWall(currentPos, d));
+    /* 枝刈りの統計 */
+    pruner.update(maze, maze.getStart(), maze.getGoals());
+    Accumulate(sum, pruner.getStats());
+    ++count;
+    /* 現在地のゴール判定 */
+    const auto& goals = maze.getGoalSet();
+    if (goals.contains(currentPos))
+      break;
+    /* 未知壁はないものとしてゴールへ向かう */
+    const auto moveDirs = stepMap.calcShortestDirections(
+        maze, currentPos, goals, false, true);
+    if (moveDirs.empty()) {
+      MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
+      return count;
+    }
+    /* 未知壁のある区画まで進む */
+    for (const auto nextDir : moveDirs) {
+      currentPos = currentPos.next(nextDir);
+      if (maze.unknownCount(currentPos)) break;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief main 関数
+ */
+int main(int argc, char* argv[]) {
+  std::vector<std::string> filepaths(argv + 1, argv + argc);
+  if (filepaths.empty()) filepaths = {"../mazedata/data/16MM2018CX.maze"};
+  /* 表の見出し */
+  std::cout << std::setw(24) << "[cells]" << std::setw(10) << "unreach"
+            << std::setw(10) << "deadend" << std::setw(10) << "artic"
+            << std::setw(10) << "detour" << std::setw(10) << "total"
+            << std::endl;
+  RegionPruner pruner;
+  RegionPruner::Stats searchSum, searchedSum, targetSum;
+  int searchCount = 0, mazeCount = 0;
+  for (const auto& filepath : filepaths) {
+    /* 正解の迷路を用意 */
+    Maze mazeTarget;
+    if (!mazeTarget.parse(filepath)) {
+      std::cerr << "Failed to Parse Maze: " << filepath << std::endl;
+      continue;
+    }
+    const auto name = filepath.substr(filepath.find_last_of('/') + 1);
+    /* 探索走行中 */
+    Maze maze(mazeTarget.getGoals(), mazeTarget.getStart());
+    RegionPruner::Stats search;
+    const int count = SearchRun(maze, mazeTarget, search);
+    PrintStats(name + " (search)", search, count);
+    Accumulate(searchSum, search);
+    searchCount += count;
+    /* 探索後 */
+    pruner.update(maze, maze.getStart(), maze.getGoals());
+    Accumulate(searchedSum, pruner.getStats());
+    /* 正解の迷路 */
+    pruner.update(mazeTarget, mazeTarget.getStart(), mazeTarget.getGoals());
+    PrintStats(name + " (target)", pruner.getStats(), 1);
+    Accumulate(targetSum, pruner.getStats());
+    ++mazeCount;
+  }
+  /* 迷路集全体の平均 */
+  PrintStats("all (search)", searchSum, searchCount);
+  PrintStats("all (searched)", searchedSum, mazeCount);
+  PrintStats("all (target)", targetSum, mazeCount);
+  return 0;
+}
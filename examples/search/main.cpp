@@ -8,8 +8,7 @@
 /*
  * 標準ライブラリの読み込み
  */
-#include <algorithm>  //< for std::find
-#include <thread>     //< for std::this_thread::sleep_for
+#include <thread>  //< for std::this_thread::sleep_for
 
 /*
  * 迷路ライブラリの読み込み
@@ -37,7 +36,7 @@ void MoveRobot(const Direction relativeDir) {
     case Direction::Back:
       return /* <引き返しの処理> */;
     default:
-      MAZE_LOGE << "invalid direction: " << relativeDir << std::endl;
+      MAZE_LOGE << "invalid direction: " << relativeDir << MAZE_LOG_ENDL;
       return;
   }
 }
@@ -91,15 +90,15 @@ int SearchRun(Maze& maze, const Maze& mazeTarget) {
     maze.updateWall(currentPos, currentDir + Direction::Left, wall_left);
     maze.updateWall(currentPos, currentDir + Direction::Right, wall_right);
     /* 現在地のゴール判定 */
-    const auto& goals = maze.getGoals();
-    if (std::find(goals.cbegin(), goals.cend(), currentPos) != goals.cend())
+    const auto& goals = maze.getGoalSet();
+    if (goals.contains(currentPos))
       break;
     /* 現在地からゴールへの移動経路を、未知壁はないものとして導出 */
     const auto moveDirs = stepMap.calcShortestDirections(
-        maze, currentPos, maze.getGoals(), false, true);
+        maze, currentPos, goals, false, true);
     /* エラー処理 */
     if (moveDirs.empty()) {
-      MAZE_LOGE << "Failed to Find a path to goal!" << std::endl;
+      MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
       return -1;
     }
     /* 未知壁のある区画に当たるまで進む */
@@ -146,7 +145,7 @@ int SearchRun(Maze& maze, const Maze& mazeTarget) {
         maze, currentPos, shortestCandidates, false, true);
     /* エラー処理 */
     if (moveDirs.empty()) {
-      MAZE_LOGE << "Failed to Find a path to goal!" << std::endl;
+      MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
       return -1;
     }
     /* 未知壁のある区画に当たるまで進む */
@@ -173,7 +172,7 @@ int SearchRun(Maze& maze, const Maze& mazeTarget) {
         maze, currentPos, {maze.getStart()}, true, true);
     /* エラー処理 */
     if (moveDirs.empty()) {
-      MAZE_LOGE << "Failed to Find a path to goal!" << std::endl;
+      MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
       return -1;
     }
     /* 経路上を進む */
@@ -202,7 +201,7 @@ int ShortestRun(const Maze& maze) {
   const auto shortestDirs = stepMap.calcShortestDirections(
       maze, maze.getStart(), maze.getGoals(), true, false);
   if (shortestDirs.empty()) {
-    MAZE_LOGE << "Failed to Find a path to goal!" << std::endl;
+    MAZE_LOGE << "Failed to Find a path to goal!" << MAZE_LOG_ENDL;
     return -1;
   }
   /* 最短走行 */
@@ -0,0 +1,72 @@
+/**
+ * @file BatchPlanner.h
+ * @brief 多数の経路導出をスレッドプールでまとめて処理するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+#include "./ThreadPool.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 多数の始点・目的地の組の経路導出を並列にまとめて処理するクラス
+ * @details
+ * - 同じ迷路に対する多数の問い合わせ (距離行列、候補の評価など) 向け
+ * - 迷路は読み取り専用で全ワーカーに共有される
+ * - ステップマップはワーカーごとにひとつ確保して使い回す
+ * - 結果は問い合わせと同じ順に返す
+ */
+class BatchPlanner {
+ public:
+  /**
+   * @brief 経路導出の問い合わせ
+   */
+  struct Query {
+    Position start; /**< @brief 始点区画 */
+    Positions dest; /**< @brief 目的地区画の集合(順不同) */
+  };
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param pool 処理に使用するスレッドプール
+   */
+  explicit BatchPlanner(ThreadPool& pool)
+      : pool(pool), stepMaps(pool.size()) {}
+  /**
+   * @brief 各問い合わせの最短経路をまとめて導出する
+   * @param[in] maze 使用する迷路
+   * @param[in] queries 問い合わせの配列
+   * @param[in] knownOnly 未知壁は壁ありとみなし、既知壁のみを使用する
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   * @return 問い合わせと同じ順の最短経路の方向列の配列。
+   *         経路がない場合は空配列となる。
+   */
+  std::vector<Directions> calcShortestDirections(
+      const Maze& maze, const std::vector<Query>& queries,
+      const bool knownOnly, const bool simple);
+  /**
+   * @brief 各問い合わせの始点区画のステップ (経路のコスト) をまとめて求める
+   * @details 経路の方向列を生成しない分、距離行列などの用途で軽量。
+   * @param[in] maze 使用する迷路
+   * @param[in] queries 問い合わせの配列
+   * @param[in] knownOnly 未知壁は壁ありとみなし、既知壁のみを使用する
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   * @return 問い合わせと同じ順のステップの配列。
+   *         経路がない場合は StepMap::STEP_MAX となる。
+   */
+  std::vector<StepMap::step_t> calcSteps(const Maze& maze,
+                                         const std::vector<Query>& queries,
+                                         const bool knownOnly,
+                                         const bool simple);
+
+ private:
+  ThreadPool& pool;              /**< @brief スレッドプール */
+  std::vector<StepMap> stepMaps; /**< @brief ワーカーごとのステップマップ */
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,99 @@
+/**
+ * @file ConnectivityTracker.h
+ * @brief 未知壁を通過可能とみなした迷路の連結性を逐次管理するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 未知壁を通過可能とみなした (楽観的な) 迷路の連結成分を管理するクラス
+ * @details
+ * - 区画ごとに連結成分の番号を保持し、到達可能性を定数時間で判定する
+ * - 壁が閉じたときは、壁の両側から交互に幅優先探索を行い、
+ *   先に探索し尽くした (小さい) 側のみ新しい番号を付け直す
+ * - 壁が開いたとき (既知の壁との不一致など) は、小さい側の番号を付け替える
+ *
+ * ```
+ * ConnectivityTracker tracker;
+ * tracker.update(maze);
+ * tracker.updateWall(maze, p, d, b);  //< maze.updateWall() の代わり
+ * if (!tracker.isReachable(maze.getStart(), maze.getGoals())) ...
+ * ```
+ */
+class ConnectivityTracker {
+ public:
+  /**
+   * @brief 迷路の壁情報を取り込み、前回からの変化を連結成分に反映する
+   * @details 初回は全体を幅優先探索で番号付けする。
+   * @param[in] maze 取り込む迷路
+   */
+  void update(const Maze& maze);
+  /**
+   * @brief 迷路の壁を更新し、連結成分に反映する
+   * @details 引数と戻り値は Maze::updateWall() と同じ。
+   */
+  bool updateWall(Maze& maze, const Position p, const Direction d,
+                  const bool b, const bool pushRecords = true);
+  /**
+   * @brief 2区画が (未知壁を通過可能とみなして) 連結かどうか
+   */
+  bool isReachable(const Position a, const Position b) const {
+    return a.isInsideOfField() && b.isInsideOfField() &&
+           labels[a.getIndex()] == labels[b.getIndex()];
+  }
+  /**
+   * @brief 区画の集合のいずれかと連結かどうか
+   */
+  bool isReachable(const Position a, const Positions& dest) const {
+    for (const auto b : dest)
+      if (isReachable(a, b)) return true;
+    return false;
+  }
+  /**
+   * @brief 区画から到達できない未知壁を列挙する
+   * @details これらの壁は、探索しても経路に影響しない。
+   * @param[in] p 基準の区画 (通常は現在の区画)
+   */
+  WallIndexes getUnreachableUnknownWalls(const Position p) const;
+  /** @brief 区画の連結成分の番号 */
+  int getLabel(const Position p) const { return labels[p.getIndex()]; }
+  /** @brief 連結成分の数 */
+  int getComponentCount() const;
+  /** @brief これまでに番号を付け直した区画の延べ数 */
+  int getRelabelCount() const { return relabelCount; }
+
+ private:
+  std::array<uint16_t, Position::SIZE> labels; /**< @brief 連結成分の番号 */
+  std::array<uint16_t, Position::SIZE> sizes;  /**< @brief 番号ごとの区画数 */
+  /** @brief 両側からの探索の訪問印 */
+  std::array<uint32_t, Position::SIZE> marks{};
+  uint32_t stamp = 0;                 /**< @brief 訪問印の世代 */
+  bool initialized = false;           /**< @brief 取り込み済みかどうか */
+  std::bitset<WallIndex::SIZE> wall;  /**< @brief 取り込んだ壁情報 */
+  std::bitset<WallIndex::SIZE> known; /**< @brief 取り込んだ既知壁情報 */
+  int relabelCount = 0;               /**< @brief 付け直した区画の延べ数 */
+
+  /** @brief 取り込んだ壁情報で、隣接区画へ移動可能か (未知壁は可能) */
+  bool canGo(const Position p, const Direction d) const {
+    const auto i = WallIndex(p, d);
+    return i.isInsideOfField() && !wall[i.getIndex()];
+  }
+  /** @brief 全区画を幅優先探索で番号付けする */
+  void rebuild();
+  /** @brief 通過可能か変化した壁を連結成分に反映する */
+  void apply(const WallIndex i, const bool wasPassable);
+  /** @brief 閉じた壁の両側が分断されたか調べ、分断されたら番号を付け直す */
+  void split(const Position a, const Position b);
+  /** @brief 開いた壁の両側の連結成分を併合する */
+  void merge(const Position a, const Position b);
+  /** @brief 未使用の番号を取得する */
+  uint16_t getFreeLabel() const;
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,143 @@
+/**
+ * @file CorridorGraph.h
+ * @brief 通路を縮約したグラフで経路を導出するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 幅1の通路を縮約し、袋小路を枝刈りしたグラフで経路を導出するクラス
+ * @details
+ * 既知区画の多い迷路で、区画ごとの展開を省いて多数の問い合わせに答える。
+ * - 袋小路の木 (分岐のない行き止まり) は枝刈りし、根元への方向のみを保持する
+ * - 残った区画のうち、隣接区画が2つの区画 (通路) は重み付きの辺に縮約する
+ * - スタート区画とゴール区画は常にノードとして残す
+ * - 経路探索は縮約したグラフ上の Dijkstra 法で行う
+ * - 経路の復元は、ノードごとに記録した目的地側の辺と通路を直接たどる
+ * - コストは隣接区画の移動をすべて1とする (StepMap の simple=true に相当)
+ * - update() で迷路の壁情報を比較し、変化があった場合のみ再構築する
+ */
+class CorridorGraph {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr step_t STEP_MAX = StepMap::STEP_MAX; /**< @brief 最大値 */
+
+ public:
+  /**
+   * @brief 迷路に変化があればグラフを再構築する
+   * @param[in] maze 使用する迷路
+   * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
+   * @return true: 再構築した、false: 変化がなく再構築しなかった
+   */
+  bool update(const Maze& maze, const bool knownOnly);
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短距離を求める
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短距離 [区画]。経路がない場合は STEP_MAX
+   */
+  step_t calcStep(const Position start, const Positions& dest);
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短経路を導出する
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短経路の方向列。経路がない場合は空配列
+   */
+  Directions calcShortestDirections(const Position start,
+                                    const Positions& dest);
+  /** @brief 縮約後のノード数 */
+  int getNodeCount() const { return nodes.size(); }
+  /** @brief 縮約後の辺の数 */
+  int getEdgeCount() const { return edges.size(); }
+  /** @brief 枝刈りされずに残った区画の数 */
+  int getKeptCellCount() const { return keptCellCount; }
+
+ private:
+  /** @brief 区画の種類 */
+  enum Kind : uint8_t {
+    Pruned,   /**< @brief 枝刈りされた袋小路 */
+    Node,     /**< @brief ノード */
+    Corridor, /**< @brief 辺に縮約された通路 */
+  };
+  /** @brief 縮約した通路の辺 */
+  struct Edge {
+    uint16_t u; /**< @brief 始点ノード */
+    uint16_t v; /**< @brief 終点ノード */
+    step_t w;   /**< @brief 重み (区画数) */
+  };
+  /** @brief ノードから目的地への経路 */
+  struct Route {
+    uint16_t edge;   /**< @brief 目的地側へ向かう辺 (なければ UNASSIGNED) */
+    Position target; /**< @brief edge がない場合に、直接接続する目的地 */
+  };
+  /** @brief 区画ごとの情報 */
+  struct Cell {
+    Kind kind;     /**< @brief 種類 */
+    int8_t to;     /**< @brief Pruned: 根元への方向 (根なら Direction::Max) */
+    uint16_t id;   /**< @brief Node: ノード番号、Corridor: 辺の番号 */
+    step_t offset; /**< @brief Corridor: 辺の始点ノードからの距離 */
+  };
+
+  /** @brief 番号が割り当てられていないことを表す値 */
+  static constexpr uint16_t UNASSIGNED = 0xffff;
+
+  bool knownOnly = false;                 /**< @brief 構築時の条件 */
+  bool built = false;                     /**< @brief 構築済みかどうか */
+  std::bitset<WallIndex::SIZE> wall;      /**< @brief 構築時の壁情報 */
+  std::bitset<WallIndex::SIZE> known;     /**< @brief 構築時の既知壁情報 */
+  Position start;                         /**< @brief 構築時のスタート区画 */
+  Positions goals;                        /**< @brief 構築時のゴール区画 */
+  std::array<Cell, Position::SIZE> cells; /**< @brief 区画ごとの情報 */
+  Positions nodes;                        /**< @brief ノードの区画 */
+  std::vector<Edge> edges;                /**< @brief 辺 */
+  /** @brief ノードごとの接続する辺の番号 */
+  std::vector<std::vector<uint16_t>> adjacency;
+  std::vector<step_t> distances; /**< @brief 目的地からのノードの距離 */
+  std::vector<Route> routes;     /**< @brief ノードから目的地への経路 */
+  int keptCellCount = 0;         /**< @brief 残った区画の数 */
+
+  /** @brief 構築時の壁情報で、隣接区画へ移動可能か */
+  bool canGo(const Position p, const Direction d) const {
+    const auto i = WallIndex(p, d);
+    return i.isInsideOfField() && !wall[i.getIndex()] &&
+           (!knownOnly || known[i.getIndex()]);
+  }
+  /** @brief グラフを構築する */
+  void build();
+  /** @brief 区画からノードへの接続 (ノード番号と距離) を列挙する */
+  template <typename F>
+  void forEachAttachment(Position p, step_t extra, const F& f) const;
+  /** @brief 枝刈りされた区画を根元へたどり、残った区画 (または根) を返す */
+  Position climb(Position p, step_t& depth) const;
+  /** @brief 同じ袋小路の木の中の、最も近い共通の祖先 (depth は根元まで) */
+  Position findCommonAncestor(Position p, step_t dp, Position t,
+                              step_t dt) const;
+  /** @brief ノードを経由しない、同じ通路または同じ袋小路の中の距離 */
+  step_t calcLocalStep(const Position p, const Position t) const;
+  /** @brief 目的地からのノードの距離と経路を求める */
+  void calcDistances(const Positions& dest);
+  /** @brief 袋小路を stop まで根元へたどる方向を追加する */
+  void appendClimb(Position p, const Position stop, Directions& dirs) const;
+  /** @brief 通路を stop またはノードまでたどる方向を追加する */
+  void appendCorridor(Position p, const bool towardU, const Position stop,
+                      Directions& dirs) const;
+  /** @brief 区画から接続するノード n へ距離 s でたどる方向を追加する */
+  void appendAttachment(Position p, const uint16_t n, const step_t s,
+                        Directions& dirs) const;
+  /** @brief ノード n から辺 e をたどる方向を追加する */
+  void appendEdge(const uint16_t n, const uint16_t e, Directions& dirs) const;
+  /** @brief ノードを経由しない区画 p から t への方向を追加する */
+  void appendLocal(const Position p, const Position t, Directions& dirs) const;
+  /** @brief 末尾の方向列を、逆向きにたどる方向列に置き換える */
+  static void reverseTail(Directions& dirs, const size_t from);
+  /** @brief calcDistances() の後、区画から目的地までの距離を求める */
+  step_t calcStepFrom(const Position p, const Positions& dest) const;
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,124 @@
+/**
+ * @file DualStepMap.h
+ * @brief 既知壁のみと未知壁を通過可能とした2種類のステップを同時に求めるクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <functional>  //< for std::greater
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 既知壁のみのステップと未知壁を通過可能としたステップを
+ * 1回の走査で同時に求めるステップマップ
+ * @details
+ * 最短経路の確定判定や探索候補の選択では、同じ目的地に対する
+ * knownOnly=true と knownOnly=false の両方のステップマップが必要になる。
+ * - 区画ごとに2種類のステップを隣り合わせて保持する
+ * - 1つの優先度付きキューで展開する。キューの要素は1つのステップと、
+ *   そのステップに更新された側 (レーン) の集合を持つ
+ * - 両方のレーンが同じステップの区画は、1回の展開と直線の走査を共有する。
+ *   未知壁を通過可能とした側は未知壁を越えて、既知壁のみの側は
+ *   既知壁のみを越えて緩和する
+ *
+ * それぞれのレーンは StepMap と同じ順序で展開されるため、
+ * simple によらず StepMap::update() の結果と一致する。
+ * 探索済みの範囲では2種類のステップの多くが等しく、走査の大半を共有できる。
+ */
+class DualStepMap {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr step_t STEP_MAX = StepMap::STEP_MAX; /**< @brief 最大値 */
+  /** @brief 区画の2種類のステップ */
+  struct Steps {
+    step_t known;      /**< @brief 既知壁のみを通過可能としたステップ */
+    step_t optimistic; /**< @brief 未知壁も通過可能としたステップ */
+    bool operator==(const Steps& obj) const {
+      return known == obj.known && optimistic == obj.optimistic;
+    }
+    bool operator!=(const Steps& obj) const { return !(*this == obj); }
+  };
+
+ public:
+  /**
+   * @brief デフォルトコンストラクタ
+   * @details 台形加速のコストテーブルは StepMap と同じものを用いる
+   */
+  DualStepMap();
+  /** @brief 全区画のステップを最大値にする */
+  void reset() { steps.fill({STEP_MAX, STEP_MAX}); }
+  /**
+   * @brief 2種類のステップマップを同時に更新する
+   * @param[in] maze 更新に使用する迷路情報
+   * @param[in] dest ステップを0とする目的地の区画の集合(順不同)
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   */
+  void update(const Maze& maze, const PositionSet& dest, const bool simple);
+  void update(const Maze& maze, const Positions& dest, const bool simple) {
+    update(maze, PositionSet(dest), simple);
+  }
+  /**
+   * @brief ステップの取得
+   * @param[in] knownOnly true:既知壁のみ、false:未知壁も通過可能
+   * @details 盤面外なら `STEP_MAX` を返す
+   */
+  step_t getStep(const Position p, const bool knownOnly) const {
+    const auto s = getSteps(p);
+    return knownOnly ? s.known : s.optimistic;
+  }
+  /**
+   * @brief 2種類のステップの取得
+   * @details 盤面外なら両方 `STEP_MAX` を返す
+   */
+  Steps getSteps(const Position p) const {
+    return p.isInsideOfField() ? steps[p.getIndex()]
+                               : Steps{STEP_MAX, STEP_MAX};
+  }
+  /**
+   * @brief 区画から目的地への既知壁のみの経路が最短であることが確定したか
+   * @details 未知壁がどうであっても、これより短い経路は存在しない。
+   */
+  bool isKnownShortest(const Position p) const {
+    const auto s = getSteps(p);
+    return s.known != STEP_MAX && s.known == s.optimistic;
+  }
+  /** @brief ステップの生配列への参照を取得 (読み取り専用) */
+  const auto& getMapArray() const { return steps; }
+  /**
+   * @brief 直前の更新の計数を取得する
+   * @details 両方のレーンで共有した展開と緩和は1回と数える。
+   * 緩和の回数以外は、MAZE_STEP_MAP_COUNTERS が 1 の場合のみ計数する。
+   */
+  const StepMap::Counters& getCounters() const { return counters; }
+
+ private:
+  /** @brief レーンの集合のビット */
+  enum Lane : uint8_t {
+    Known = 1,      /**< @brief 既知壁のみを通過可能とした側 */
+    Optimistic = 2, /**< @brief 未知壁も通過可能とした側 */
+  };
+  /**
+   * @brief ステップの更新予約のキューの要素
+   * @details 上位から ステップ (16 bit), 区画の y, x, レーンの集合 (2 bit) を
+   * 詰めた整数で、昇順に取り出す。ステップが同じ場合は StepMap と同じく
+   * Position::data の順となる。
+   * レーンのステップが変化した場合、そのレーンは古いものとして読み飛ばす。
+   */
+  using Element = uint32_t;
+  /** @brief 区画ごとの2種類のステップ */
+  std::array<Steps, Position::SIZE> steps;
+  /** @brief 台形加速を考慮した移動コストテーブル (StepMap と同じ) */
+  std::array<step_t, MAZE_SIZE> stepTable;
+  /** @brief ステップの更新予約のキュー (最小の要素から取り出す) */
+  std::priority_queue<Element, std::vector<Element>, std::greater<Element>>
+      queue;
+  /** @brief 更新の計数 */
+  StepMap::Counters counters;
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,123 @@
+/**
+ * @file HierarchicalPlanner.h
+ * @brief 迷路をクラスタに分割して階層的に経路を導出するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 迷路を固定サイズのクラスタに分割して経路を導出するクラス (HPA*)
+ * @details
+ * - クラスタ境界の通過可能な箇所の両側の区画を入口とする
+ * - クラスタごとに入口間の (クラスタ内のみを通る) 距離を求めて保持する
+ * - 壁が変化したクラスタのみ無効化し、必要になったときに再計算する
+ * - 入口を節点とする抽象グラフ上を A* 探索し、経路上のクラスタのみ詳細化する
+ * - コストは隣接区画の移動をすべて1とする (StepMap の simple=true に相当)
+ *
+ * 境界の通過箇所をすべて入口とするため、抽象グラフ上の最短経路は
+ * 元の迷路の最短経路と一致する (最適解との差の上限 getCostBound() は 0)。
+ */
+class HierarchicalPlanner {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr step_t STEP_MAX = StepMap::STEP_MAX; /**< @brief 最大値 */
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param clusterSize クラスタの1辺の区画数
+   */
+  explicit HierarchicalPlanner(const int clusterSize = 8);
+  /**
+   * @brief 迷路の壁情報を取り込み、変化した壁を含むクラスタを無効化する
+   * @param[in] maze 使用する迷路
+   * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
+   */
+  void update(const Maze& maze, const bool knownOnly);
+  /**
+   * @brief 壁の両側のクラスタを無効化する
+   * @param[in] i 変化した壁
+   */
+  void invalidate(const WallIndex i);
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短距離を求める
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短距離 [区画]。経路がない場合は STEP_MAX
+   */
+  step_t calcStep(const Position start, const Positions& dest);
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短経路を導出する
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短経路の方向列。経路がない場合は空配列
+   */
+  Directions calcShortestDirections(const Position start,
+                                    const Positions& dest);
+  /**
+   * @brief 導出した経路のコストと最適なコストとの差の上限
+   * @details 境界の通過箇所をすべて入口とするため、常に 0
+   */
+  static constexpr step_t getCostBound() { return 0; }
+  /** @brief これまでに入口間の距離を計算したクラスタの延べ数 */
+  int getRebuildCount() const { return rebuildCount; }
+  /** @brief 直前の経路導出で詳細化したクラスタの数 */
+  int getRefinedClusterCount() const { return refinedClusterCount; }
+
+ private:
+  /** @brief クラスタ */
+  struct Cluster {
+    bool dirty = true;   /**< @brief 入口間の距離の再計算が必要 */
+    Positions entrances; /**< @brief 入口の区画 */
+    /** @brief 入口間の距離 (entrances.size() × entrances.size()) */
+    std::vector<step_t> costs;
+  };
+  /** @brief ステップの配列 */
+  using StepArray = std::array<step_t, Position::SIZE>;
+
+  const int clusterSize;         /**< @brief クラスタの1辺の区画数 */
+  const int clusterCount;        /**< @brief 1辺あたりのクラスタ数 */
+  std::vector<Cluster> clusters; /**< @brief クラスタ */
+  /** @brief 区画の、所属するクラスタの入口の中での番号 (入口でなければ -1) */
+  std::array<int16_t, Position::SIZE> entranceIndex;
+  bool knownOnly = false;             /**< @brief 取り込み時の条件 */
+  bool initialized = false;           /**< @brief 取り込み済みかどうか */
+  std::bitset<WallIndex::SIZE> wall;  /**< @brief 取り込んだ壁情報 */
+  std::bitset<WallIndex::SIZE> known; /**< @brief 取り込んだ既知壁情報 */
+  int rebuildCount = 0;               /**< @brief 再計算の延べ数 */
+  int refinedClusterCount = 0;        /**< @brief 詳細化したクラスタ数 */
+  /** @brief 抽象グラフ上の最短経路 (区画の列) */
+  Positions route;
+
+  /** @brief 取り込んだ壁情報で、隣接区画へ移動可能か */
+  bool canGo(const Position p, const Direction d) const {
+    const auto i = WallIndex(p, d);
+    return i.isInsideOfField() && !wall[i.getIndex()] &&
+           (!knownOnly || known[i.getIndex()]);
+  }
+  /** @brief 区画の所属するクラスタの番号 */
+  int getClusterId(const Position p) const {
+    return p.x / clusterSize * clusterCount + p.y / clusterSize;
+  }
+  /** @brief 無効化されていれば入口と入口間の距離を再計算してクラスタを返す */
+  const Cluster& getCluster(const int id);
+  /**
+   * @brief クラスタ内のみを通る幅優先探索
+   * @param[in] sources 距離0とする区画の集合 (同じクラスタ内)
+   * @param[out] steps クラスタ内の区画の距離 (クラスタ外は不定)
+   */
+  void searchInCluster(const Positions& sources, StepArray& steps) const;
+  /** @brief クラスタ内の経路を src から dst の集合へ詳細化して追記する */
+  void refineInCluster(const Position src, const Positions& dst,
+                       Directions& dirs) const;
+  /** @brief 抽象グラフ上を探索し、経路を route に格納する */
+  step_t searchRoute(const Position start, const Positions& dest);
+};
+
+}  // namespace MazeLib
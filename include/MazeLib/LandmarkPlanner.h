@@ -0,0 +1,109 @@
+/**
+ * @file LandmarkPlanner.h
+ * @brief ランドマークによる下界を用いた A* 探索で経路を導出するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief ランドマークによる下界を用いた A* 探索 (ALT) で経路を導出するクラス
+ * @details
+ * 同じ迷路に対する多数の2点間の問い合わせ向け。
+ * - 前処理として、いくつかのランドマーク区画からのステップマップを保持する
+ * - 三角不等式 |d(L,u) - d(L,t)| <= d(u,t) による下界を A* の評価に用いる
+ * - コストは隣接区画の移動をすべて1とする (StepMap の simple=true に相当)
+ *
+ * 壁が増える (通過可能な箇所が減る) だけの変化では下界は許容的なままなので、
+ * ステップマップは再計算しない。通過可能な箇所が増えた場合や
+ * invalidate() が呼ばれた場合は、次の update() で再計算する。
+ */
+class LandmarkPlanner {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr step_t STEP_MAX = StepMap::STEP_MAX; /**< @brief 最大値 */
+
+ public:
+  /**
+   * @brief ランドマークを設定する
+   * @details 未設定の場合は、迷路の四隅とスタート区画とゴール区画とする。
+   * @param[in] landmarks ランドマーク区画の集合
+   */
+  void setLandmarks(const Positions& landmarks);
+  /** @brief ランドマーク区画の集合を取得する */
+  const Positions& getLandmarks() const { return landmarks; }
+  /**
+   * @brief ランドマークのステップマップを無効化し、次の update() で再計算させる
+   */
+  void invalidate() { valid = false; }
+  /**
+   * @brief 迷路の壁情報を取り込み、必要ならランドマークを再計算する
+   * @param[in] maze 使用する迷路
+   * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
+   * @return true: 再計算した、false: 再計算しなかった
+   */
+  bool update(const Maze& maze, const bool knownOnly);
+  /**
+   * @brief 2区画間の距離の下界を求める
+   * @return 距離の下界。到達不能と判明した場合は STEP_MAX
+   */
+  step_t getLowerBound(const Position u, const Position t) const;
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短距離を求める
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短距離 [区画]。経路がない場合は STEP_MAX
+   */
+  step_t calcStep(const Position start, const Positions& dest);
+  /**
+   * @brief 始点区画から目的地区画の集合までの最短経路を導出する
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @return 最短経路の方向列。経路がない場合は空配列
+   */
+  Directions calcShortestDirections(const Position start,
+                                    const Positions& dest);
+  /** @brief 直前の探索で展開した区画の数 */
+  int getExpandedCount() const { return expandedCount; }
+  /** @brief ランドマークを計算した延べ回数 */
+  int getRefreshCount() const { return refreshCount; }
+
+ private:
+  using StepArray = std::array<step_t, Position::SIZE>;
+
+  Positions landmarks;                /**< @brief ランドマーク区画 */
+  std::vector<StepArray> stepMaps;    /**< @brief ランドマークからの距離 */
+  bool valid = false;                 /**< @brief stepMaps が有効か */
+  bool knownOnly = false;             /**< @brief 取り込み時の条件 */
+  std::bitset<WallIndex::SIZE> wall;  /**< @brief 取り込んだ壁情報 */
+  std::bitset<WallIndex::SIZE> known; /**< @brief 取り込んだ既知壁情報 */
+  /** @brief stepMaps を計算したときに通過可能だった壁 */
+  std::bitset<WallIndex::SIZE> passable;
+  StepArray steps;      /**< @brief 探索中の始点からの距離 */
+  int expandedCount = 0; /**< @brief 展開した区画の数 */
+  int refreshCount = 0;  /**< @brief 再計算の延べ回数 */
+  /** @brief 探索中の区画への進入方向 */
+  std::array<int8_t, Position::SIZE> from;
+
+  /** @brief 取り込んだ壁情報で、隣接区画へ移動可能か */
+  bool canGo(const Position p, const Direction d) const {
+    const auto i = WallIndex(p, d);
+    return i.isInsideOfField() && !wall[i.getIndex()] &&
+           (!knownOnly || known[i.getIndex()]);
+  }
+  /** @brief 幅優先探索で区画からの距離を求める */
+  void searchFrom(const Position p, StepArray& steps) const;
+  /**
+   * @brief A* 探索
+   * @param[out] end 到達した目的地区画
+   * @return 最短距離。経路がない場合は STEP_MAX
+   */
+  step_t search(const Position start, const Positions& dest, Position& end);
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,90 @@
+/**
+ * @file LookAheadPlanner.h
+ * @brief 走行中に次区画の経路を先読み計算するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <future>  //< for std::future
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 次区画の壁の有無の全組み合わせについて経路を先読み計算するクラス
+ * @details
+ * 探索走行中、次区画へ移動している間に、次区画の前・左・右の壁の有無
+ * (最大8通り) それぞれを仮定した経路を並列に計算しておく。
+ * 次区画に到達してセンサで壁を確認したら、一致する経路を即座に取り出せる。
+ * 既知の壁は仮定の対象にしないので、計算するのは未知壁の組み合わせのみ。
+ *
+ * ```
+ * LookAheadPlanner planner;
+ * // 次区画へ移動を開始すると同時に先読みを開始
+ * planner.start(maze, Pose(nextPos, nextDir), maze.getGoals(), false, true);
+ * MoveRobot(...);
+ * // 次区画に到達したら壁を確認して迷路を更新し、計画を取り出す
+ * maze.updateWall(...);
+ * const auto moveDirs = planner.get(wall_front, wall_left, wall_right);
+ * ```
+ */
+class LookAheadPlanner {
+ public:
+  /** @brief 壁の有無の組み合わせの数 (前・左・右) */
+  static constexpr int CASE_SIZE = 8;
+
+ public:
+  /**
+   * @brief 先読み計算を開始する
+   * @details 前回の先読み計算が残っている場合は、その完了を待ってから開始する。
+   * @param[in] maze 現在の迷路 (内部で複製される)
+   * @param[in] next 次に到達する区画と、そこに向かう方向
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @param[in] knownOnly 未知壁は壁ありとみなし、既知壁のみを使用する
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   */
+  void start(const Maze& maze, const Pose& next, const Positions& dest,
+             const bool knownOnly, const bool simple);
+  /**
+   * @brief センサで確認した壁に一致する経路を取り出す
+   * @details 計算が終わっていなければ完了を待つ。
+   * 既知の壁とセンサの結果が食い違った場合は、その場で計算し直す。
+   * @param[in] wallFront,wallLeft,wallRight 次区画の前・左・右の壁の有無
+   * @return 次区画から目的地区画への最短経路の方向列。
+   *         経路がない場合は空配列となる。
+   */
+  Directions get(const bool wallFront, const bool wallLeft,
+                 const bool wallRight);
+
+ private:
+  Maze maze;               /**< @brief 先読み開始時の迷路 */
+  Pose next;               /**< @brief 次に到達する位置姿勢 */
+  Positions dest;          /**< @brief 目的地区画の集合 */
+  bool knownOnly = false;  /**< @brief 既知壁のみを使用するか */
+  bool simple = false;     /**< @brief 台形加速を考慮しないか */
+  uint8_t unknownMask = 0; /**< @brief 未知壁のビット (前・左・右) */
+  /** @brief 組み合わせごとの計算結果 */
+  std::array<std::future<Directions>, CASE_SIZE> futures;
+
+  /**
+   * @brief 前・左・右の壁の有無を仮定して経路を計算する
+   */
+  static Directions plan(Maze maze, const Pose& next, const Positions& dest,
+                         const bool knownOnly, const bool simple,
+                         const std::array<bool, 3>& walls);
+  /**
+   * @brief 前・左・右の方向
+   */
+  std::array<Direction, 3> getDirections() const {
+    return {{
+        Direction(next.d + Direction::Front),
+        Direction(next.d + Direction::Left),
+        Direction(next.d + Direction::Right),
+    }};
+  }
+};
+
+}  // namespace MazeLib
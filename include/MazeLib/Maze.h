@@ -7,15 +7,29 @@
  */
 #pragma once
 
+#include <algorithm>    //< for std::min, std::max
 #include <array>
 #include <bitset>
-#include <cmath>     //< for std::log2
-#include <cstdint>   //< for uint8_t
-#include <fstream>   //< for std::ifstream
-#include <iostream>  //< for std::cout
+#include <cmath>        //< for std::log2
+#include <cstdint>      //< for uint8_t
+#include <cstdio>       //< for snprintf
+#include <iterator>     //< for std::forward_iterator_tag
 #include <string>
+#include <type_traits>  //< for std::enable_if_t
+#include <utility>      //< for std::declval
 #include <vector>
 
+/*
+ * iostream を使わない構成 (マイコン向け)
+ * MAZE_IOSTREAM_DISABLED を定義すると、iostream と fstream を使う
+ * 迷路の表示、読み込み、ファイル保存の関数を除外する。
+ * ログは MazeLib::setLogSink() で設定した関数に渡される。
+ */
+#ifndef MAZE_IOSTREAM_DISABLED
+#include <fstream>   //< for std::ifstream
+#include <iostream>  //< for std::cout
+#endif
+
 /* debug profiling option */
 #define MAZE_DEBUG_PROFILING 0
 #if MAZE_DEBUG_PROFILING
@@ -36,7 +50,7 @@ static int microseconds() __attribute__((unused));
     if (dur > dur_max) {                                             \
       dur_max = dur;                                                 \
       MAZE_LOGD << __func__ << "(" << #id << ")\t" << dur << " [us]" \
-                << std::endl;                                        \
+                << MAZE_LOG_ENDL;                                    \
     }                                                                \
   }
 #else
@@ -68,31 +82,40 @@ static int microseconds() __attribute__((unused));
 /**
  * @brief ログ出力の選択
  * @details 0: None, 1: Error, 2: Warn, 3: Info, 4: Debug
+ * ログの行末には、どちらの構成でも使える MAZE_LOG_ENDL を書く。
  */
 #ifndef MAZE_LOG_LEVEL
 #define MAZE_LOG_LEVEL 4
 #endif
-#define MAZE_LOG_STREAM_BASE(s, l, c) \
-  (s << c "[" l "][" __FILE__ ":" << __LINE__ << "]" C_NO "\t")
+#ifndef MAZE_IOSTREAM_DISABLED
+#define MAZE_LOG_STREAM_BASE(l, c) \
+  (std::cout << c "[" l "][" __FILE__ ":" << __LINE__ << "]" C_NO "\t")
+#define MAZE_LOG_STREAM_NULL std::ostream(0)
+#define MAZE_LOG_ENDL std::endl
+#else
+#define MAZE_LOG_STREAM_BASE(l, c) MazeLib::LogLine(l[0], __FILE__, __LINE__)
+#define MAZE_LOG_STREAM_NULL MazeLib::LogLine(0, nullptr, 0)
+#define MAZE_LOG_ENDL ""
+#endif
 #if MAZE_LOG_LEVEL >= 1
-#define MAZE_LOGE MAZE_LOG_STREAM_BASE(std::cout, "E", C_RE)
+#define MAZE_LOGE MAZE_LOG_STREAM_BASE("E", C_RE)
 #else
-#define MAZE_LOGE std::ostream(0)
+#define MAZE_LOGE MAZE_LOG_STREAM_NULL
 #endif
 #if MAZE_LOG_LEVEL >= 2
-#define MAZE_LOGW MAZE_LOG_STREAM_BASE(std::cout, "W", C_YE)
+#define MAZE_LOGW MAZE_LOG_STREAM_BASE("W", C_YE)
 #else
-#define MAZE_LOGW std::ostream(0)
+#define MAZE_LOGW MAZE_LOG_STREAM_NULL
 #endif
 #if MAZE_LOG_LEVEL >= 3
-#define MAZE_LOGI MAZE_LOG_STREAM_BASE(std::cout, "I", C_GR)
+#define MAZE_LOGI MAZE_LOG_STREAM_BASE("I", C_GR)
 #else
-#define MAZE_LOGI std::ostream(0)
+#define MAZE_LOGI MAZE_LOG_STREAM_NULL
 #endif
 #if MAZE_LOG_LEVEL >= 4
-#define MAZE_LOGD MAZE_LOG_STREAM_BASE(std::cout, "D", C_BL)
+#define MAZE_LOGD MAZE_LOG_STREAM_BASE("D", C_BL)
 #else
-#define MAZE_LOGD std::ostream(0)
+#define MAZE_LOGD MAZE_LOG_STREAM_NULL
 #endif
 
 /**
@@ -100,6 +123,75 @@ static int microseconds() __attribute__((unused));
  */
 namespace MazeLib {
 
+#ifdef MAZE_IOSTREAM_DISABLED
+/**
+ * @brief ログの出力先の関数の型
+ * @param level ログの種類。 'E', 'W', 'I', 'D' のいずれか
+ * @param file ログを出力したソースファイル名
+ * @param line ログを出力した行番号
+ * @param message ログの本文 (末尾の改行は含まない)
+ */
+using LogSink = void (*)(char level, const char* file, int line,
+                         const char* message);
+/**
+ * @brief ログの出力先を設定する
+ * @param sink 出力先の関数。 nullptr ならログを破棄する (初期値)
+ */
+void setLogSink(const LogSink sink);
+/**
+ * @brief ログの出力先を取得する
+ */
+LogSink getLogSink();
+/**
+ * @brief iostream を使わずに1行分のログを組み立てるクラス
+ * @details MAZE_LOGE などが生成する一時オブジェクトで、文の終わりで
+ * setLogSink() の関数に渡す。行末の MAZE_LOG_ENDL は何も追記しない。
+ * 文字列、文字、整数、浮動小数点数、 toString() を持つ型を表示できる。
+ */
+class LogLine {
+ public:
+  LogLine(const char level, const char* file, const int line)
+      : level(level), file(file), line(line) {}
+  ~LogLine() {
+    const auto sink = getLogSink();
+    if (level && sink) sink(level, file, line, buffer);
+  }
+  LogLine& operator<<(const char* s) { return append("%s", s); }
+  LogLine& operator<<(const char c) { return append("%c", c); }
+  LogLine& operator<<(const float v) {
+    return append("%g", static_cast<double>(v));
+  }
+  LogLine& operator<<(const double v) { return append("%g", v); }
+  template <typename T,
+            std::enable_if_t<std::is_integral<T>::value, int> = 0>
+  LogLine& operator<<(const T v) {
+    return append("%lld", static_cast<long long>(v));
+  }
+  template <typename T,
+            typename = decltype(std::declval<const T&>().toString())>
+  LogLine& operator<<(const T& obj) {
+    return append("%s", obj.toString());
+  }
+
+ private:
+  char level;       /**< @brief ログの種類。 0 なら出力しない */
+  const char* file; /**< @brief ソースファイル名 */
+  int line;         /**< @brief 行番号 */
+  char buffer[128] = {}; /**< @brief 本文。あふれた分は切り捨てる */
+  size_t length = 0;     /**< @brief 本文の長さ */
+
+  /** @brief 書式に従って本文に追記する */
+  template <typename... Args>
+  LogLine& append(const char* format, const Args... args) {
+    if (!level || length + 1 >= sizeof(buffer)) return *this;
+    const int n =
+        snprintf(buffer + length, sizeof(buffer) - length, format, args...);
+    if (n > 0) length = std::min(length + n, sizeof(buffer) - 1);
+    return *this;
+  }
+};
+#endif
+
 /**
  * @brief 迷路の1辺の区画数の定数。
  */
@@ -204,12 +296,14 @@ class Direction {
    * @brief 表示用char型へのキャスト
    */
   char toChar() const { return ">'^`<,v.X"[d]; }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief stream 表示
    */
   friend std::ostream& operator<<(std::ostream& os, const Direction d) {
     return os << d.toChar();
   }
+#endif
   /**
    * @brief 斜めではない4方向の配列 (for文などで使用)
    */
@@ -246,11 +340,13 @@ static_assert(sizeof(Direction) == 1, "size error");
  *  @brief Direction 構造体の動的配列、集合
  */
 using Directions = std::vector<Direction>;
+#ifndef MAZE_IOSTREAM_DISABLED
 /**
  * @brief Directions の stream 表示
  * @details >^<v の形式
  */
 std::ostream& operator<<(std::ostream& os, const Directions& obj);
+#endif
 
 /**
  * @brief 迷路の区画の位置(座標)を定義。
@@ -324,10 +420,38 @@ struct Position {
   }
   /**
    * @brief 自分の引数方向に隣接した区画の Position を返す
+   * @details 方向ごとの変位の表を引くのみで、分岐を含まない。
    * @param d 隣接方向
    * @return 隣接区画の座標
    */
-  Position next(const Direction d) const;
+  constexpr Position next(const Direction d) const {
+    return Position(x + NEXT_X[d], y + NEXT_Y[d]);
+  }
+  /**
+   * @brief 区画の配列をまとめて引数方向に隣接した区画に移す
+   * @details x と y を 16bit の整数の各バイトとみなし、
+   * バイトごとの加算 (SWAR) で変位を加える。コンパイラによる
+   * ベクトル化が効くように、要素ごとの分岐を含まない。
+   * @param[in] src 元の区画の配列
+   * @param[out] dst 隣接区画の書き込み先 (src と同じでもよい)
+   * @param[in] n 要素数
+   * @param[in] d 隣接方向
+   */
+  static void nextBatch(const Position* src, Position* dst, const int n,
+                        const Direction d) {
+    const uint16_t o = Position(NEXT_X[d], NEXT_Y[d]).data;
+    for (int i = 0; i < n; ++i) {
+      const uint16_t v = src[i].data;
+      dst[i].data = ((v & 0x7F7F) + (o & 0x7F7F)) ^ ((v ^ o) & 0x8080);
+    }
+  }
+  /**
+   * @brief 区画の配列の通し番号 (getIndex()) をまとめて求める
+   * @details 迷路外の区画の場合未定義動作となる。
+   */
+  static void getIndexBatch(const Position* src, uint16_t* dst, const int n) {
+    for (int i = 0; i < n; ++i) dst[i] = src[i].getIndex();
+  }
   /**
    * @brief フィールド内かどうかを判定する関数
    * @return true フィールド内
@@ -341,10 +465,14 @@ struct Position {
   }
   /**
    * @brief 座標を回転変換する
-   * @param d 回転角度, 4方位のみ
+   * @details 方向ごとの cos, sin の表を引くのみで、分岐を含まない。
+   * @param d 回転角度, 4方位のみ (斜め方向の場合は変換しない)
    * @return 変換後の位置
    */
-  Position rotate(const Direction d) const;
+  constexpr Position rotate(const Direction d) const {
+    return Position(ROTATE_C[d] * x - ROTATE_S[d] * y,
+                    ROTATE_S[d] * x + ROTATE_C[d] * y);
+  }
   /**
    * @brief 座標を回転変換する
    * @param d 回転角度, 4方位のみ
@@ -354,10 +482,12 @@ struct Position {
   Position rotate(const Direction d, const Position center) const {
     return center + (*this - center).rotate(d);
   }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief output-stream の表示関数。 (  x,  y) の形式
    */
   friend std::ostream& operator<<(std::ostream& os, const Position p);
+#endif
   /**
    * @brief 表示用文字列に変換する
    */
@@ -366,14 +496,163 @@ struct Position {
     snprintf(str, sizeof(str), "(%02d, %02d)", x, y);
     return str;
   }
+
+ private:
+  /** @brief 方向ごとの隣接区画への変位 */
+  static constexpr std::array<int8_t, Direction::Max> NEXT_X = {
+      1, 1, 0, -1, -1, -1, 0, 1};
+  static constexpr std::array<int8_t, Direction::Max> NEXT_Y = {
+      0, 1, 1, 1, 0, -1, -1, -1};
+  /** @brief 方向ごとの回転の cos, sin。斜め方向は恒等変換とする */
+  static constexpr std::array<int8_t, Direction::Max> ROTATE_C = {
+      1, 1, 0, 1, -1, 1, 0, 1};
+  static constexpr std::array<int8_t, Direction::Max> ROTATE_S = {
+      0, 0, 1, 0, 0, 0, -1, 0};
 };
 static_assert(sizeof(Position) == 2, "size error");
+static_assert(Position(1, 2).next(Direction::NorthWest).x == 0 &&
+                  Position(1, 2).next(Direction::NorthWest).y == 3,
+              "table error");
 
 /**
  * @brief Position 構造体の動的配列、集合
  */
 using Positions = std::vector<Position>;
 
+/**
+ * @brief 区画の集合。区画の数のビット列で表す。
+ * @details
+ * - 所属の確認 contains() は O(1)
+ * - 走査は 64 bit ごとに最下位の 1 の位置 (ctz) を求めて行う。
+ *   順序は Position::getIndex() の昇順
+ * - 区画の最小最大の座標を保持する
+ *
+ * 迷路外の区画は追加されない。
+ */
+class PositionSet {
+ public:
+  /** @brief 64 bit のワードの数 */
+  static constexpr int WORD_SIZE = (Position::SIZE + 63) / 64;
+  /** @brief 前方向のイテレータ */
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Position;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Position*;
+    using reference = Position;
+    const_iterator(const PositionSet& set, const int w) : set(&set), w(w) {
+      bits = w < WORD_SIZE ? set.words[w] : 0;
+      skip();
+    }
+    Position operator*() const {
+      return Position::getPositionFromIndex(w * 64 + __builtin_ctzll(bits));
+    }
+    const_iterator& operator++() {
+      bits &= bits - 1;  //< 最下位の 1 を消す
+      skip();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const auto it = *this;
+      ++*this;
+      return it;
+    }
+    bool operator==(const const_iterator& obj) const {
+      return w == obj.w && bits == obj.bits;
+    }
+    bool operator!=(const const_iterator& obj) const { return !(*this == obj); }
+
+   private:
+    const PositionSet* set;
+    int w;
+    uint64_t bits;
+    /** @brief 空のワードを飛ばす */
+    void skip() {
+      while (!bits && w < WORD_SIZE)
+        if (++w < WORD_SIZE) bits = set->words[w];
+    }
+  };
+
+ public:
+  PositionSet() { clear(); }
+  /** @brief 区画の動的配列から作る。重複と迷路外の区画は除かれる。 */
+  explicit PositionSet(const Positions& positions) : PositionSet() {
+    for (const auto p : positions) insert(p);
+  }
+  /** @brief 区画が含まれるか */
+  bool contains(const Position p) const {
+    const auto i = p.getIndex();
+    return p.isInsideOfField() && (words[i / 64] >> (i % 64) & 1);
+  }
+  /**
+   * @brief 区画を追加する
+   * @return true: 追加した、false: 迷路外または追加済み
+   */
+  bool insert(const Position p) {
+    if (!p.isInsideOfField() || contains(p)) return false;
+    const auto i = p.getIndex();
+    words[i / 64] |= uint64_t(1) << (i % 64);
+    ++count;
+    min_x = std::min(p.x, min_x);
+    min_y = std::min(p.y, min_y);
+    max_x = std::max(p.x, max_x);
+    max_y = std::max(p.y, max_y);
+    return true;
+  }
+  /**
+   * @brief 区画を削除する。最小最大の座標を再計算する。
+   * @return true: 削除した、false: 含まれていない
+   */
+  bool erase(const Position p) {
+    if (!contains(p)) return false;
+    const auto i = p.getIndex();
+    words[i / 64] &= ~(uint64_t(1) << (i % 64));
+    --count;
+    calcRange();
+    return true;
+  }
+  /** @brief すべての区画を削除する */
+  void clear() {
+    words.fill(0);
+    count = 0;
+    calcRange();
+  }
+  /** @brief 区画の数 */
+  int size() const { return count; }
+  bool empty() const { return count == 0; }
+  /**
+   * @brief 区画の最小最大の座標。空の場合は最小が MAZE_SIZE - 1、最大が 0
+   */
+  int8_t getMinX() const { return min_x; }
+  int8_t getMinY() const { return min_y; }
+  int8_t getMaxX() const { return max_x; }
+  int8_t getMaxY() const { return max_y; }
+  /** @brief 区画の動的配列に変換する (Position::getIndex() の昇順) */
+  Positions toPositions() const { return Positions(begin(), end()); }
+  const_iterator begin() const { return const_iterator(*this, 0); }
+  const_iterator end() const { return const_iterator(*this, WORD_SIZE); }
+  bool operator==(const PositionSet& obj) const { return words == obj.words; }
+  bool operator!=(const PositionSet& obj) const { return words != obj.words; }
+
+ private:
+  std::array<uint64_t, WORD_SIZE> words; /**< @brief 区画のビット列 */
+  int count;                             /**< @brief 区画の数 */
+  int8_t min_x, min_y, max_x, max_y;     /**< @brief 最小最大の座標 */
+
+  /** @brief 最小最大の座標を計算する */
+  void calcRange() {
+    min_x = min_y = MAZE_SIZE - 1;
+    max_x = max_y = 0;
+    for (const auto p : *this) {
+      min_x = std::min(p.x, min_x);
+      min_y = std::min(p.y, min_y);
+      max_x = std::max(p.x, max_x);
+      max_y = std::max(p.y, max_y);
+    }
+  }
+};
+
 /**
  * @brief Position と Direction をまとめた型。位置姿勢。
  * @details アライメント制約により実体は 4Bytes。
@@ -406,10 +685,12 @@ struct Pose {
   Pose next(const Direction nextDirection) const {
     return Pose(p.next(nextDirection), nextDirection);
   }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief ostream での表示
    */
   friend std::ostream& operator<<(std::ostream& os, const Pose& pose);
+#endif
   /**
    * @brief 表示用文字列に変換する
    */
@@ -524,10 +805,12 @@ struct WallIndex {
     // return z == 0 ? Direction::East : Direction::North;
     return z << 1;  //< 高速化
   }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief 表示用演算子のオーバーロード。 ( x, y, d) の形式
    */
   friend std::ostream& operator<<(std::ostream& os, const WallIndex i);
+#endif
   /**
    * @brief 壁がフィールド内か判定する関数
    * @details (x, y) が (0, 0) と (MAZE_SIZE-1, MAZE_SIZE-1) の間、かつ、
@@ -546,10 +829,48 @@ struct WallIndex {
   }
   /**
    * @brief 引数方向の WallIndex を取得する関数
+   * @details 方向と z ごとの変位の表を引くのみで、分岐を含まない。
+   * 斜め方向では z が反転する。
    * @param d 隣接方向
    * @return WallIndex 隣接壁
    */
-  WallIndex next(const Direction d) const;
+  constexpr WallIndex next(const Direction d) const {
+    const int k = d * 2 + z;
+    return WallIndex(x + NEXT_X[k], y + NEXT_Y[k], z ^ (d & 1));
+  }
+  /**
+   * @brief 壁の配列をまとめて引数方向の壁に移す
+   * @details x, y, z を 16bit の整数の各ビット列とみなし、z ごとの変位を
+   * ビット演算による加算 (SWAR) で加える。コンパイラによる
+   * ベクトル化が効くように、要素ごとの分岐を含まない。
+   * @param[in] src 元の壁の配列
+   * @param[out] dst 隣接壁の書き込み先 (src と同じでもよい)
+   * @param[in] n 要素数
+   * @param[in] d 隣接方向
+   */
+  static void nextBatch(const WallIndex* src, WallIndex* dst, const int n,
+                        const Direction d) {
+    /* z ごとの変位。上位ビット (z) は反転の有無を表す */
+    const uint16_t offsets[2] = {
+        WallIndex(NEXT_X[d * 2], NEXT_Y[d * 2], d & 1).data,
+        WallIndex(NEXT_X[d * 2 + 1], NEXT_Y[d * 2 + 1], d & 1).data,
+    };
+    for (int i = 0; i < n; ++i) {
+      const uint16_t v = src[i].data;
+      const uint16_t o = offsets[v >> 15];
+      /* x は 8bit、y は 7bit で桁上がりを捨て、z は排他的論理和 */
+      const uint16_t sum = (v & 0x7F7F) + (o & 0x7F7F);
+      dst[i].data = ((sum ^ ((v ^ o) & 0x0080)) & 0x7FFF) | ((v ^ o) & 0x8000);
+    }
+  }
+  /**
+   * @brief 壁の配列の通し番号 (getIndex()) をまとめて求める
+   * @attention 迷路外の壁の場合未定義動作となる。
+   */
+  static void getIndexBatch(const WallIndex* src, uint16_t* dst,
+                            const int n) {
+    for (int i = 0; i < n; ++i) dst[i] = src[i].getIndex();
+  }
   /**
    * @brief 現在壁に隣接する、柱ではない6方向を取得
    * @return std::array<Direction, 6> 隣接方向の配列
@@ -583,6 +904,11 @@ struct WallIndex {
         break;
     }
   }
+  /** @brief 方向と z ごとの隣接壁への変位。添字は d * 2 + z */
+  static constexpr std::array<int8_t, Direction::Max * 2> NEXT_X = {
+      1, 1, 1, 0, 0, 0, 0, -1, -1, -1, 0, -1, 0, 0, 1, 0};
+  static constexpr std::array<int8_t, Direction::Max * 2> NEXT_Y = {
+      0, 0, 0, 1, 1, 1, 0, 1, 0, 0, -1, 0, -1, -1, -1, 0};
 };
 static_assert(sizeof(WallIndex) == 2, "size error");
 
@@ -624,8 +950,10 @@ struct WallRecord {
   const Position getPosition() const { return Position(x, y); }
   /** @brief 方向の取得 */
   const Direction getDirection() const { return d; }
+#ifndef MAZE_IOSTREAM_DISABLED
   /** @brief 表示 */
   friend std::ostream& operator<<(std::ostream& os, const WallRecord& obj);
+#endif
 };
 static_assert(sizeof(WallRecord) == 2, "size error");
 
@@ -652,7 +980,7 @@ class Maze {
    */
   Maze(const Positions& goals = Positions(),
        const Position start = Position(0, 0))
-      : goals(goals), start(start) {
+      : goals(goals), goalSet(goals), start(start) {
     reset();
   }
   /**
@@ -756,6 +1084,7 @@ class Maze {
    * @return 既知壁の数 0~4
    */
   int8_t unknownCount(const Position p) const;
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief 迷路の表示
    */
@@ -809,6 +1138,7 @@ class Maze {
     maze.parse(is);
     return is;
   }
+#endif
   /**
    * @brief 配列から迷路を読み込むパーサ
    * @param data 各区画16進表記の文字列配列
@@ -819,7 +1149,14 @@ class Maze {
   /**
    * @brief ゴール区画の集合を更新
    */
-  void setGoals(const Positions& goals) { this->goals = goals; }
+  void setGoals(const Positions& goals) {
+    this->goals = goals;
+    goalSet = PositionSet(goals);
+  }
+  void setGoals(const PositionSet& goals) {
+    this->goals = goals.toPositions();
+    goalSet = goals;
+  }
   /**
    * @brief スタート区画を更新
    */
@@ -828,6 +1165,10 @@ class Maze {
    * @brief ゴール区画の集合を取得
    */
   const Positions& getGoals() const { return goals; }
+  /**
+   * @brief ゴール区画の集合を取得。ゴール判定などに用いる。
+   */
+  const PositionSet& getGoalSet() const { return goalSet; }
   /**
    * @brief スタート区画を取得
    */
@@ -836,6 +1177,14 @@ class Maze {
    * @brief 壁ログを取得
    */
   const WallRecords& getWallRecords() const { return wallRecords; }
+  /**
+   * @brief 壁情報のビット列を取得。ビット位置は WallIndex::getIndex() の値。
+   */
+  const std::bitset<WallIndex::SIZE>& getWallBits() const { return wall; }
+  /**
+   * @brief 壁の既知未知情報のビット列を取得。ビット位置は WallIndex::getIndex()
+   */
+  const std::bitset<WallIndex::SIZE>& getKnownBits() const { return known; }
   /**
    * @brief 既知部分の迷路サイズを返す。計算量を減らすために使用。
    */
@@ -843,6 +1192,7 @@ class Maze {
   int8_t getMinY() const { return min_y; }
   int8_t getMaxX() const { return max_x; }
   int8_t getMaxY() const { return max_y; }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief 壁ログをファイルに追記保存する関数
    */
@@ -852,11 +1202,80 @@ class Maze {
    * @brief 壁ログファイルから壁情報を復元する関数
    */
   bool restoreWallRecordsFromFile(const std::string& filepath);
+#endif
+  /**
+   * @brief 2つの迷路の壁情報の差分
+   * @details ビット位置は WallIndex::getIndex() の値。
+   */
+  struct Diff {
+    /** @brief 両方で既知かつ壁の有無が異なる壁 */
+    std::bitset<WallIndex::SIZE> mismatched;
+    /** @brief 比較元で未知かつ比較先で既知の壁 */
+    std::bitset<WallIndex::SIZE> unknown;
+    /** @brief ビット列を WallIndex の集合に変換する */
+    static WallIndexes toWallIndexes(const std::bitset<WallIndex::SIZE>& bits);
+  };
+  /**
+   * @brief 他の迷路との壁情報の差分をビット列の演算で求める
+   * @details 探索結果と正解の迷路の比較などに用いる。
+   * @param other 比較先の迷路 (正解の迷路など)
+   */
+  Diff diff(const Maze& other) const {
+    return {(wall ^ other.wall) & known & other.known, other.known & ~known};
+  }
+  /**
+   * @brief 両方で既知かつ壁の有無が異なる場合の解決方法
+   */
+  enum MergePolicy : uint8_t {
+    KeepThis,    /**< @brief この迷路の壁を残す */
+    TakeOther,   /**< @brief 他の迷路の壁を採用する */
+    MarkUnknown, /**< @brief 未知壁にする (updateWall() の不一致と同じ) */
+    PreferWall,  /**< @brief 壁ありとする */
+  };
+  /**
+   * @brief 他の迷路の壁情報をビット列の演算で取り込む
+   * @details この迷路で未知かつ他の迷路で既知の壁は、他の迷路の壁を採用する。
+   * 複数回の走行で得た壁情報をまとめるときなどに用いる。
+   * @param other 取り込む迷路
+   * @param policy 両方で既知かつ壁の有無が異なる場合の解決方法
+   * @param pushRecords 変化した壁を壁更新の記録に追加する。
+   * 記録を updateWall() で再生すると、取り込み後と同じ壁情報になる
+   * @return 両方で既知かつ壁の有無が異なった壁の数
+   */
+  int merge(const Maze& other, const MergePolicy policy,
+            const bool pushRecords = true);
+  /** @brief 対称変換の数 */
+  static constexpr int SYMMETRY_SIZE = 8;
+  /**
+   * @brief 迷路全体の対称変換 (回転と鏡映)
+   * @details 壁と既知壁のビット列を行列とみなし、ビット行列の転置と
+   * 行のビット反転により変換する。ゴール区画とスタート区画も変換する。
+   * - 迷路の1辺 size の外の壁は削除し、size の外周の壁は既知の壁ありとする
+   * - 壁更新の記録は引き継がない
+   * @param symmetry 対称変換の番号。
+   * symmetry % 4 が反時計回りの 90° 回転の回数、
+   * symmetry >= 4 のとき回転の前に対角線 (x = y) について鏡映する。
+   * 0 と 4 はスタート区画 (0,0) を動かさない。
+   * @param size 迷路の1辺の区画数
+   * @return 変換後の迷路
+   */
+  Maze transform(const int symmetry, const int size = MAZE_SIZE) const;
+  /**
+   * @brief 区画の対称変換
+   * @param p 変換する区画
+   * @param symmetry 対称変換の番号 (Maze::transform() と同じ)
+   * @param size 迷路の1辺の区画数
+   */
+  static Position transformPosition(const Position p, const int symmetry,
+                                    const int size = MAZE_SIZE);
+  /** @brief 方向の対称変換 */
+  static Direction transformDirection(const Direction d, const int symmetry);
 
  protected:
   std::bitset<WallIndex::SIZE> wall;  /**< @brief 壁情報 */
   std::bitset<WallIndex::SIZE> known; /**< @brief 壁の既知未知情報 */
   Positions goals;                    /**< @brief ゴール区画の集合 */
+  PositionSet goalSet;                /**< @brief ゴール区画の集合 */
   Position start;                     /**< @brief スタート区画 */
   WallRecords wallRecords;            /**< @brief 更新した壁のログ */
   int8_t min_x;                       /**< @brief 既知壁の最小区画 */
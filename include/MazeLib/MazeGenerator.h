@@ -0,0 +1,97 @@
+/**
+ * @file MazeGenerator.h
+ * @brief 性能評価用に迷路を自動生成するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief シード値から決定的に迷路を生成するクラス
+ * @details
+ * - 乱数は SplitMix64 で自前に生成するので、処理系によらず同じ迷路になる
+ * - 1辺 size 区画の正方形の迷路を、迷路全体の左下に生成する
+ * - 生成した迷路の壁はすべて既知とする。size の外側の区画は壁で閉じる
+ * - スタート区画は (0,0) で、East の壁あり、North の壁なし
+ *
+ * ```
+ * MazeGenerator generator(seed);
+ * const auto maze = generator.generate(MazeGenerator::Braided, 16);
+ * MazeGenerator::save(maze, "braided.maze", 16);
+ * ```
+ */
+class MazeGenerator {
+ public:
+  /** @brief 迷路の形状 */
+  enum Topology : uint8_t {
+    Perfect,     /**< @brief 深さ優先探索による閉路のない迷路 */
+    Braided,     /**< @brief 袋小路をなくして閉路を作った迷路 */
+    Open,        /**< @brief 壁の多くを取り除いた開けた迷路 */
+    Serpentine,  /**< @brief 蛇行する1本の長い通路 (シード値によらない) */
+    Competition, /**< @brief 中央にゴール区画の部屋がある大会風の迷路 */
+    TopologyMax, /**< @brief 形状の数 */
+  };
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param seed 乱数のシード値
+   */
+  explicit MazeGenerator(const uint64_t seed = 0) : state(seed) {}
+  /**
+   * @brief 迷路を生成する
+   * @param topology 迷路の形状
+   * @param size 迷路の1辺の区画数 (2 以上 MAZE_SIZE 以下に丸める)
+   * @return 生成した迷路。ゴール区画も設定される
+   */
+  Maze generate(const Topology topology, const int size = MAZE_SIZE);
+#ifndef MAZE_IOSTREAM_DISABLED
+  /**
+   * @brief 迷路を *.maze 形式のファイルに保存する
+   * @param maze 保存する迷路
+   * @param filepath 保存先のファイルパス
+   * @param size 迷路の1辺の区画数
+   * @return true: 成功、false: 失敗
+   */
+  static bool save(const Maze& maze, const std::string& filepath,
+                   const int size = MAZE_SIZE);
+#endif
+  /** @brief 形状の名前 */
+  static const char* getName(const Topology topology);
+
+ private:
+  uint64_t state; /**< @brief 乱数の状態 */
+
+  /** @brief 乱数 (SplitMix64) */
+  uint64_t next() {
+    uint64_t z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+  /** @brief 0 以上 n 未満の整数の乱数 */
+  int uniform(const int n) { return next() % n; }
+  /** @brief 確率 percent [%] で true */
+  bool chance(const int percent) { return uniform(100) < percent; }
+  /**
+   * @brief 深さ優先探索で閉路のない迷路を掘る
+   * @param visited 掘らない区画を true にしておく (スタート区画は除く)
+   */
+  void carve(Maze& maze, const int size,
+             std::bitset<Position::SIZE>& visited);
+  /**
+   * @brief 袋小路の壁を確率 percent [%] で取り除く
+   * @param excluded 壁を取り除いて通じさせない区画
+   */
+  void braid(Maze& maze, const int size, const int percent,
+             const std::bitset<Position::SIZE>& excluded);
+  /** @brief 両側の区画が迷路内で、壁を取り除いてよいか */
+  static bool isRemovable(const WallIndex i, const int size);
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,88 @@
+/**
+ * @file MazeIndex.h
+ * @brief 探索途中の迷路と矛盾しない過去の迷路を検索する索引を定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 過去の迷路の集合から、探索途中の迷路と矛盾しない迷路を検索する索引
+ * @details
+ * - 登録した迷路ごとに、Maze::transform() による 8 通りの対称変換を保持する
+ * - 区画ごとの4方向の壁のパターンから、対称変換の一覧への転置索引を作る
+ * - 検索では、4方向とも既知の区画のうち最も候補の少ない区画で候補を絞り、
+ *   壁と既知壁のビット列の演算で、すべての既知壁と一致するかを確かめる
+ */
+class MazeIndex {
+ public:
+  /** @brief 対称変換の数 */
+  static constexpr int SYMMETRY_SIZE = Maze::SYMMETRY_SIZE;
+  /** @brief 検索結果 */
+  struct Match {
+    int id;           /**< @brief 登録した迷路の番号 */
+    uint8_t symmetry; /**< @brief 対称変換の番号 (Maze::transform()) */
+  };
+
+ public:
+  /**
+   * @brief 全既知の迷路を登録する
+   * @param[in] maze 登録する迷路
+   * @param[in] size 迷路の1辺の区画数
+   * @param[in] name 迷路の名前
+   * @return 登録した迷路の番号
+   */
+  int add(const Maze& maze, const int size, const std::string& name = "");
+#ifndef MAZE_IOSTREAM_DISABLED
+  /**
+   * @brief *.maze 形式のファイルから迷路を読み込んで登録する
+   * @return 登録した迷路の番号。読み込みに失敗した場合は -1
+   */
+  int add(const std::string& filepath);
+#endif
+  /** @brief 登録した迷路の数 */
+  int size() const { return names.size(); }
+  /** @brief 登録した迷路の名前 */
+  const std::string& getName(const int id) const { return names[id]; }
+  /**
+   * @brief 既知壁がすべて一致する迷路と対称変換の組を検索する
+   * @param[in] maze 探索途中の迷路
+   * @return 一致した迷路と対称変換の組の集合 (登録順)
+   */
+  std::vector<Match> find(const Maze& maze) const;
+  /**
+   * @brief 検索結果の壁情報を取得する
+   * @return 対称変換後の壁のビット列。ビット位置は WallIndex::getIndex()
+   */
+  const std::bitset<WallIndex::SIZE>& getWallBits(const Match& m) const {
+    return variants[m.id * SYMMETRY_SIZE + m.symmetry];
+  }
+  /**
+   * @brief 検索結果のうち、壁に壁があるものの割合を求める
+   * @details 未知壁を確認する優先順位の事前情報として用いる。
+   * @return 壁ありの割合。検索結果が空なら 0.5
+   */
+  float calcWallRatio(const std::vector<Match>& matches,
+                      const WallIndex i) const;
+
+ private:
+  /** @brief 区画の4方向の壁のパターンの数 */
+  static constexpr int PATTERN_SIZE = 16;
+
+  std::vector<std::string> names; /**< @brief 登録した迷路の名前 */
+  /** @brief 対称変換後の壁 (迷路の番号 * SYMMETRY_SIZE + 対称変換の番号) */
+  std::vector<std::bitset<WallIndex::SIZE>> variants;
+  /** @brief 区画と壁のパターンから、対称変換後の迷路の一覧への転置索引 */
+  std::array<std::vector<uint16_t>, Position::SIZE * PATTERN_SIZE> postings;
+
+  /** @brief 区画の4方向の壁のパターン */
+  static int getPattern(const std::bitset<WallIndex::SIZE>& wall,
+                        const Position p);
+};
+
+}  // namespace MazeLib
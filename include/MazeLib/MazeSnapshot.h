@@ -0,0 +1,115 @@
+/**
+ * @file MazeSnapshot.h
+ * @brief 読み取り専用の迷路スナップショットを並行に公開するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <atomic>  //< for std::atomic
+#include <memory>  //< for std::unique_ptr
+#include <utility>
+
+#include "./Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 不変な迷路のスナップショットをロックなしで公開するクラス
+ * @details
+ * - 書き込み側 (単一) は publish() で迷路のコピーを新しい版として公開する
+ * - 読み込み側は read() で得た Reader が生きている間、その版を参照できる
+ * - 版の切り替えはアトミックなポインタ交換で行い、読み込み側はロックしない
+ * - 古い版はエポックベースの回収により、参照中の読み込み側がいなくなってから
+ *   再利用される。書き込み側が読み込み側を待つことはない。
+ *
+ * ```
+ * MazeSnapshots snapshots;
+ * // 書き込み側: 壁を更新するたびに公開
+ * snapshots.publish(maze);
+ * // 読み込み側 (読み込み側ごとに固有の ID を使う)
+ * const auto reader = snapshots.read(0);
+ * stepMap.update(*reader, reader->getGoals(), false, false);
+ * ```
+ */
+class MazeSnapshots {
+ public:
+  /** @brief 同時に読み込み可能な読み込み側の最大数 */
+  static constexpr int READER_MAX = 8;
+
+  /**
+   * @brief 公開された迷路の版
+   */
+  struct Snapshot {
+    Maze maze;        /**< @brief 迷路の複製 */
+    uint32_t version; /**< @brief 版番号。公開するたびに増加する */
+  };
+
+  /**
+   * @brief スナップショットの参照を保持する RAII クラス
+   * @details 生存中は参照している版が回収されない。
+   * 長時間保持すると古い版の回収が遅れるので、計画ごとに取得し直すこと。
+   */
+  class Reader {
+   public:
+    Reader(MazeSnapshots& owner, const int id);
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    /** @brief 迷路の参照 */
+    const Maze& operator*() const { return snapshot->maze; }
+    const Maze* operator->() const { return &snapshot->maze; }
+    /** @brief 版番号の取得 */
+    uint32_t getVersion() const { return snapshot->version; }
+
+   private:
+    std::atomic<uint32_t>& epoch;  /**< @brief 自身の読み込みエポック */
+    const Snapshot* snapshot;      /**< @brief 参照中の版 */
+  };
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param maze 最初に公開する迷路
+   */
+  MazeSnapshots(const Maze& maze = Maze());
+  /**
+   * @brief 迷路を新しい版として公開する (書き込み側)
+   * @details 読み込み側を待つことはない。回収可能な古い版があれば再利用する。
+   * @param maze 公開する迷路
+   * @return 公開した版番号
+   */
+  uint32_t publish(const Maze& maze);
+  /**
+   * @brief 最新の版を読み込む (読み込み側)
+   * @param id 読み込み側の固有 ID (0 <= id < READER_MAX)。
+   * 同じ ID で同時に複数の Reader を保持してはならない。
+   */
+  Reader read(const int id) { return Reader(*this, id); }
+  /**
+   * @brief 参照されなくなった古い版を回収する (書き込み側)
+   * @return 回収待ちの版の数
+   */
+  int reclaim();
+  /**
+   * @brief 最新の版番号を取得
+   */
+  uint32_t getVersion() const { return current.load()->version; }
+
+ private:
+  /** @brief 最新の版 */
+  std::atomic<const Snapshot*> current;
+  /** @brief 大域エポック。版を退避するたびに増加する */
+  std::atomic<uint32_t> epoch{1};
+  /** @brief 読み込み側ごとのエポック。0 は読み込みしていないことを表す */
+  std::array<std::atomic<uint32_t>, READER_MAX> readerEpochs{};
+  /** @brief 回収待ちの版と退避時のエポック (書き込み側のみ操作) */
+  std::vector<std::pair<uint32_t, std::unique_ptr<Snapshot>>> retired;
+  /** @brief 再利用可能な版 (書き込み側のみ操作) */
+  std::vector<std::unique_ptr<Snapshot>> pool;
+  /** @brief 最新の版の所有権 (書き込み側のみ操作) */
+  std::unique_ptr<Snapshot> owned;
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,104 @@
+/**
+ * @file RegionPruner.h
+ * @brief 最短経路に含まれ得ない区画を枝刈りするクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 始点から目的地への最短経路に含まれ得ない区画を枝刈りするクラス
+ * @details
+ * 未知壁を通過可能とみなした迷路 (どのような真の迷路よりも短い) の上で、
+ * 次の区画を無関係と判定する。
+ * - 始点または目的地から到達できない区画
+ * - 袋小路: 始点と目的地を含まない木状の部分 (次数1の区画を繰り返し除去)
+ * - 関節点の先: 関節点を通ってしか出入りできず、始点と目的地を含まない領域
+ * - 遠回り: 始点からの距離と目的地までの距離の和 (下界) が、
+ *   既知壁のみを通る経路の長さ (上界) を超える区画
+ *
+ * コストは隣接区画の移動をすべて1とする (StepMap の simple=true に相当)。
+ * seal() で無関係な区画を壁で囲った迷路を作れば、StepMap の展開も省略できる。
+ */
+class RegionPruner {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+  static constexpr step_t STEP_MAX = StepMap::STEP_MAX; /**< @brief 最大値 */
+  /** @brief 理由ごとの枝刈りした区画数 */
+  struct Stats {
+    int unreachable = 0;  /**< @brief 到達不能 */
+    int deadEnd = 0;      /**< @brief 袋小路 */
+    int articulation = 0; /**< @brief 関節点の先 */
+    int detour = 0;       /**< @brief 遠回り */
+    /** @brief 合計 */
+    int getTotal() const {
+      return unreachable + deadEnd + articulation + detour;
+    }
+  };
+
+ public:
+  /**
+   * @brief 無関係な区画を判定する
+   * @param[in] maze 使用する迷路
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @param[in] margin 遠回りの判定で上界に加える余裕 [区画]
+   */
+  void update(const Maze& maze, const Position start, const Positions& dest,
+              const int margin = 0);
+  /** @brief 区画が最短経路に含まれ得ないか */
+  bool isIrrelevant(const Position p) const {
+    return !p.isInsideOfField() || irrelevant[p.getIndex()];
+  }
+  /** @brief 壁が最短経路に影響し得ないか (いずれかの側が無関係) */
+  bool isIrrelevant(const WallIndex i) const {
+    return isIrrelevant(i.getPosition()) ||
+           isIrrelevant(i.getPosition().next(i.getDirection()));
+  }
+  /** @brief 無関係な区画の集合。ビット位置は Position::getIndex() の値 */
+  const std::bitset<Position::SIZE>& getIrrelevantBits() const {
+    return irrelevant;
+  }
+  /** @brief 既知壁のみを通る経路の長さ。経路がなければ STEP_MAX */
+  step_t getKnownCost() const { return knownCost; }
+  /** @brief 直前の判定の統計 */
+  const Stats& getStats() const { return stats; }
+  /**
+   * @brief 無関係な区画との境界に既知の壁を置く
+   * @details 経路導出用の迷路の複製に対して用いる。
+   * @param[inout] maze 壁を置く迷路
+   */
+  void seal(Maze& maze) const;
+
+ private:
+  using StepArray = std::array<step_t, Position::SIZE>;
+
+  std::bitset<Position::SIZE> irrelevant; /**< @brief 無関係な区画 */
+  std::bitset<WallIndex::SIZE> wall;      /**< @brief 取り込んだ壁情報 */
+  std::bitset<WallIndex::SIZE> known;     /**< @brief 取り込んだ既知壁情報 */
+  step_t knownCost = STEP_MAX;            /**< @brief 既知経路の長さ */
+  Stats stats;                            /**< @brief 統計 */
+
+  /** @brief 移動可能か (枝刈り済みの区画へは不可) */
+  bool canGo(const Position p, const Direction d, const bool knownOnly) const {
+    const auto i = WallIndex(p, d);
+    return i.isInsideOfField() && !wall[i.getIndex()] &&
+           (!knownOnly || known[i.getIndex()]) &&
+           !irrelevant[p.next(d).getIndex()];
+  }
+  /** @brief 幅優先探索で区画の集合からの距離を求める */
+  void searchFrom(const Positions& sources, const bool knownOnly,
+                  StepArray& steps) const;
+  /** @brief 袋小路を除去する */
+  int pruneDeadEnds(const std::bitset<Position::SIZE>& terminal);
+  /** @brief 関節点の先の領域を除去する */
+  int pruneArticulations(const Position start,
+                         const std::bitset<Position::SIZE>& terminal);
+};
+
+}  // namespace MazeLib
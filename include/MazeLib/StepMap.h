@@ -8,13 +8,27 @@
 #pragma once
 
 #include <limits>  //< for std::numeric_limits
+#include <queue>   //< for std::priority_queue
 
 #include "./Maze.h"
 
+/**
+ * @brief ステップマップの更新の計数の選択
+ * @details 0: 緩和の回数のみ (既定値), 1: キューの操作も計数する (評価用)
+ */
+#ifndef MAZE_STEP_MAP_COUNTERS
+#define MAZE_STEP_MAP_COUNTERS 0
+#endif
+
 namespace MazeLib {
 
+class ThreadPool;
+
 /**
  * @brief 区画ベースのステップマップを管理するクラス
+ * @details
+ * 既知壁のみのステップと未知壁を通過可能としたステップの両方が必要な場合は、
+ * 1回の走査で両方を求める DualStepMap を使う。
  */
 class StepMap {
  public:
@@ -65,11 +79,17 @@ class StepMap {
    * @brief ステップマップの生配列への参照を取得 (読み取り専用)
    */
   const auto& getMapArray() const { return stepMap; }
+  /**
+   * @brief 台形加速を考慮した直線の移動コストテーブルを取得
+   * @details 添字は直進する区画数。[0] は使用しない。
+   */
+  const auto& getStepTable() const { return stepTable; }
   /**
    * @brief ステップのスケーリング係数を取得
    * @details ステップにこの数をかけるとミリ秒に変換できる
    */
   const auto getScalingFactor() const { return scalingFactor; }
+#ifndef MAZE_IOSTREAM_DISABLED
   /**
    * @brief ステップの表示
    * @param[in] maze 表示する迷路
@@ -89,6 +109,7 @@ class StepMap {
   void printFull(const Maze& maze, const Directions& dirs,
                  const Position start = Position(0, 0),
                  std::ostream& os = std::cout) const;
+#endif
   /**
    * @brief ステップマップの更新
    * @param[in] maze 更新に使用する迷路情報
@@ -96,8 +117,136 @@ class StepMap {
    * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
    * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
    */
-  void update(const Maze& maze, const Positions& dest, const bool knownOnly,
+  void update(const Maze& maze, const PositionSet& dest, const bool knownOnly,
               const bool simple);
+  void update(const Maze& maze, const Positions& dest, const bool knownOnly,
+              const bool simple) {
+    update(maze, PositionSet(dest), knownOnly, simple);
+  }
+  /**
+   * @brief 中断可能なステップマップの更新を開始する
+   * @details
+   * 協調的スケジューラなどで、更新を少しずつ進めるために用いる。
+   * updateResume() が true を返すまで呼び出すと、update() と同じ結果となる。
+   * 更新が終わるまで、引数の迷路を変更・破棄してはならない。
+   * @param[in] maze 更新に使用する迷路情報
+   * @param[in] dest ステップを0とする目的地の区画の集合(順不同)
+   * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   */
+  void updateBegin(const Maze& maze, const PositionSet& dest,
+                   const bool knownOnly, const bool simple);
+  void updateBegin(const Maze& maze, const Positions& dest,
+                   const bool knownOnly, const bool simple) {
+    updateBegin(maze, PositionSet(dest), knownOnly, simple);
+  }
+  /**
+   * @brief 中断されたステップマップの更新を再開する
+   * @details 緩和 (隣接区画のステップの確認) の回数が予算に達したら中断する。
+   * 区画の展開の途中では中断しないので、1区画の展開分だけ予算を超えうる。
+   * @param[in] budget 緩和の回数の予算
+   * @return true: 更新完了、false: 未完了 (再度呼び出すこと)
+   */
+  bool updateResume(const int budget);
+  /**
+   * @brief 中断可能な更新の途中かどうか
+   */
+  bool isUpdating() const { return updateMaze != nullptr; }
+  /**
+   * @brief 中断中の更新で、値が確定したステップの上限を取得する
+   * @details
+   * 優先度付きキューの先頭のステップ以下の区画は、以降の展開で
+   * 更新されることがないため、最終的な値と一致する。
+   * 目的地から確定した区画まではステップを降りる経路が求まるので、
+   * 更新の途中でも確定した領域内の行動を決めることができる (anytime 探索)。
+   * @return 確定したステップの上限。更新中でなければ STEP_MAX
+   */
+  step_t getSettledStep() const {
+    return isUpdating() && !queue.empty() ? queue.top().s : STEP_MAX;
+  }
+  /**
+   * @brief 区画のステップが確定しているかどうか
+   * @param[in] p 区画の位置
+   * @return true: 確定済み、false: 未確定 (または到達不能)
+   */
+  bool isSettled(const Position p) const {
+    const auto s = getStep(p);
+    return s != STEP_MAX && s <= getSettledStep();
+  }
+  /**
+   * @brief 更新時に、区画ごとに最も近い目的地を記録するかを設定する
+   * @details 有効にすると、同じ更新の中でステップとともに目的地の区画を
+   * 伝播し、目的地ごとの領域分割 (ボロノイ分割) が得られる。
+   * ステップが同じ目的地が複数ある場合は、先に展開された方となる。
+   * 記録用の領域は有効にしたときに確保し、無効にすると解放する。
+   */
+  void setSourceLabeling(const bool enabled) {
+    if (!enabled)
+      sourceMap = {};
+    else if (sourceMap.empty())
+      sourceMap.assign(Position::SIZE, Position(-1, -1));
+  }
+  /**
+   * @brief 区画に最も近い目的地を取得する
+   * @details setSourceLabeling() で有効にした後の更新の結果。
+   * @return 目的地の区画。盤面外、到達不能または無効なら Position(-1, -1)
+   */
+  Position getSource(const Position p) const {
+    return getStep(p) == STEP_MAX || sourceMap.empty()
+               ? Position(-1, -1)
+               : sourceMap[p.getIndex()];
+  }
+  /**
+   * @brief 目的地の区画の生配列への参照を取得 (読み取り専用)
+   * @details 到達不能な区画の値は不定。記録が無効なら空配列
+   */
+  const auto& getSourceArray() const { return sourceMap; }
+  /**
+   * @brief ステップマップの更新の計数
+   */
+  struct Counters {
+    int pops = 0;         /**< @brief キューから取り出した回数 */
+    int expansions = 0;   /**< @brief 区画を展開した回数 */
+    int relaxations = 0;  /**< @brief 緩和の回数 */
+    int pushes = 0;       /**< @brief キューに追加した回数 */
+    int queueSizeMax = 0; /**< @brief キューの要素数の最大値 */
+  };
+  /**
+   * @brief 直前の逐次的な更新の計数を取得する
+   * @details updateBegin() で 0 に戻り、updateResume() で加算される。
+   * updateParallel() では 0 に戻すのみで、計数しない。
+   * 緩和の回数以外は、MAZE_STEP_MAP_COUNTERS が 1 の場合のみ計数する。
+   */
+  const Counters& getCounters() const { return counters; }
+  /**
+   * @brief ステップマップの並列更新
+   * @details 同じステップの区画の集合 (バケット) ごとに、
+   * 展開をスレッドプールで並列に行う。結果は update() と完全に一致する。
+   * 同じバケット内で同じ区画を更新しようとした区画のみ、
+   * update() と同じ順序で逐次的に展開し直す。
+   * @param[in] maze 更新に使用する迷路情報
+   * @param[in] dest ステップを0とする目的地の区画の集合(順不同)
+   * @param[in] knownOnly true:未知壁は通過不可能、false:未知壁は通過可能とする
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   * @param[in] pool 展開に使用するスレッドプール
+   */
+  void updateParallel(const Maze& maze, const PositionSet& dest,
+                      const bool knownOnly, const bool simple,
+                      ThreadPool& pool);
+  void updateParallel(const Maze& maze, const Positions& dest,
+                      const bool knownOnly, const bool simple,
+                      ThreadPool& pool) {
+    updateParallel(maze, PositionSet(dest), knownOnly, simple, pool);
+  }
+  /**
+   * @brief update() で並列更新を使うスレッドプールを設定する
+   * @details 展開範囲の区画数が閾値を超えたときのみ updateParallel() を使う。
+   * @param[in] pool スレッドプール。nullptr なら常に逐次的に更新する。
+   * @param[in] threshold 並列更新を使う展開範囲の区画数の閾値
+   */
+  void setThreadPool(ThreadPool* pool, const int threshold = 32 * 32) {
+    this->pool = pool, parallelThreshold = threshold;
+  }
   /**
    * @brief 与えられた区画間の最短経路を導出する関数
    * @param[in] maze 使用する迷路
@@ -108,9 +257,15 @@ class StepMap {
    * @return 始点区画から目的地区画への最短経路の方向列。
    *         経路がない場合は空配列となる。
    */
+  Directions calcShortestDirections(const Maze& maze, const Position start,
+                                    const PositionSet& dest,
+                                    const bool knownOnly, const bool simple);
   Directions calcShortestDirections(const Maze& maze, const Position start,
                                     const Positions& dest, const bool knownOnly,
-                                    const bool simple);
+                                    const bool simple) {
+    return calcShortestDirections(maze, start, PositionSet(dest), knownOnly,
+                                  simple);
+  }
   /**
    * @brief スタートからゴールまでの最短経路を導出する関数
    * @param[in] maze 使用する迷路
@@ -121,7 +276,7 @@ class StepMap {
    */
   Directions calcShortestDirections(const Maze& maze, const bool knownOnly,
                                     const bool simple) {
-    return calcShortestDirections(maze, maze.getStart(), maze.getGoals(),
+    return calcShortestDirections(maze, maze.getStart(), maze.getGoalSet(),
                                   knownOnly, simple);
   }
   /**
@@ -167,20 +322,55 @@ class StepMap {
                                        Directions& shortestDirections,
                                        const bool knownOnly,
                                        const bool diagEnabled);
-
-#if MAZE_DEBUG_PROFILING
-  int queueSizeMax = 0;
-#endif
+  /**
+   * @brief 展開範囲を計算する関数
+   * @details 既知壁の範囲と目的地を含み、外周を許した範囲
+   */
+  static void calcRange(const Maze& maze, const PositionSet& dest,
+                        int8_t& min_x, int8_t& min_y, int8_t& max_x,
+                        int8_t& max_y);
 
  protected:
   /** @brief 迷路中のステップ数 */
   std::array<step_t, Position::SIZE> stepMap;
+  /** @brief 区画ごとの最も近い目的地 (記録が無効なら空) */
+  std::vector<Position> sourceMap;
   /** @brief コストテーブルのサイズ */
   static constexpr int stepTableSize = MAZE_SIZE;
   /** @brief コストが最大値を超えないようにスケーリングする係数 */
   static constexpr float scalingFactor = 2;
   /** @brief 台形加速を考慮した移動コストテーブル (壁沿い方向) */
   std::array<step_t, MAZE_SIZE> stepTable;
+  /** @brief 並列更新に使うスレッドプール */
+  ThreadPool* pool = nullptr;
+  /** @brief 並列更新を使う展開範囲の区画数の閾値 */
+  int parallelThreshold = 0;
+  /** @brief 並列に展開するバケットの最小の区画数 */
+  static constexpr int parallelBucketMin = 16;
+
+  /**
+   * @brief ステップの更新予約のキューの要素
+   * @details ステップが同じ場合は区画の ID 順とし、展開順序を一意に定める。
+   * (updateParallel() が update() と同じ結果を得るために必要)
+   */
+  struct Element {
+    Position p;
+    step_t s;
+    bool operator<(const Element& e) const {
+      return s != e.s ? s > e.s : p.data > e.p.data;
+    }
+  };
+  /** @brief ステップの更新予約のキュー */
+  std::priority_queue<Element> queue;
+  /** @brief 更新中の迷路。更新中でなければ nullptr */
+  const Maze* updateMaze = nullptr;
+  bool updateKnownOnly = false; /**< @brief 更新中の条件 */
+  bool updateSimple = false;    /**< @brief 更新中の条件 */
+  int8_t updateMinX = 0;        /**< @brief 更新中の展開範囲 */
+  int8_t updateMinY = 0;        /**< @brief 更新中の展開範囲 */
+  int8_t updateMaxX = 0;        /**< @brief 更新中の展開範囲 */
+  int8_t updateMaxY = 0;        /**< @brief 更新中の展開範囲 */
+  Counters counters;            /**< @brief 更新の計数 */
 
   /**
    * @brief 計算の高速化のために予め直進のコストテーブルを計算する関数
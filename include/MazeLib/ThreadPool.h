@@ -0,0 +1,94 @@
+/**
+ * @file ThreadPool.h
+ * @brief ワークスティーリング方式のスレッドプールを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <condition_variable>
+#include <functional>  //< for std::function
+#include <memory>      //< for std::unique_ptr
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MazeLib {
+
+/**
+ * @brief ワークスティーリング方式のスレッドプール
+ * @details
+ * - parallelFor() により、添字 0 から n-1 のタスクを並列に実行する
+ * - 添字の範囲は最初にワーカーごとに等分され、
+ *   自分の範囲を使い切ったワーカーは他のワーカーの範囲の後ろ半分を奪う
+ * - 呼び出し元スレッドもワーカー 0 として実行に参加する
+ * - ワーカー番号を使って、ワーカーごとの作業領域を再利用できる
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief タスクの型
+   * @param worker ワーカー番号 (0 <= worker < size())
+   * @param index タスクの添字
+   */
+  using Task = std::function<void(const int worker, const int index)>;
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param size ワーカーの数 (呼び出し元スレッドを含む)。0 なら CPU 数。
+   */
+  explicit ThreadPool(const int size = 0);
+  /**
+   * @brief デストラクタ。ワーカースレッドを終了する。
+   */
+  ~ThreadPool();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  /**
+   * @brief ワーカーの数 (呼び出し元スレッドを含む)
+   */
+  int size() const { return ranges.size(); }
+  /**
+   * @brief 添字 0 から n-1 のタスクを並列に実行し、すべての完了を待つ
+   * @details 複数のスレッドから呼ばれた場合は順番に実行される。
+   * @param n タスクの数
+   * @param task 各添字に対して実行する関数
+   */
+  void parallelFor(const int n, const Task& task);
+
+ private:
+  /** @brief ワーカーごとの未実行の添字の範囲 [begin, end) */
+  struct Range {
+    std::mutex mutex;
+    int begin = 0;
+    int end = 0;
+  };
+  std::vector<std::unique_ptr<Range>> ranges; /**< @brief ワーカーの範囲 */
+  std::vector<std::thread> threads;  /**< @brief ワーカースレッド */
+  std::mutex callMutex;              /**< @brief parallelFor() の排他 */
+  std::mutex mutex;                  /**< @brief 以下の状態の排他 */
+  std::condition_variable startCv;   /**< @brief 開始の通知 */
+  std::condition_variable doneCv;    /**< @brief 完了の通知 */
+  const Task* task = nullptr;        /**< @brief 実行中のタスク */
+  uint32_t generation = 0;           /**< @brief parallelFor() の通し番号 */
+  int running = 0;                   /**< @brief 実行中のワーカーの数 */
+  bool stop = false;                 /**< @brief 終了要求 */
+
+  /**
+   * @brief ワーカースレッドの本体
+   */
+  void run(const int worker);
+  /**
+   * @brief 自分の範囲がなくなるまでタスクを実行する
+   */
+  void work(const int worker);
+  /**
+   * @brief 次に実行する添字を取得する。なければ他のワーカーから奪う。
+   * @return true: 取得成功、false: すべてのタスクが実行済み
+   */
+  bool next(const int worker, int& index);
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,107 @@
+/**
+ * @file WallRecordQueue.h
+ * @brief 割り込みから迷路へ壁情報を受け渡すロックフリーキューを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include <atomic>  //< for std::atomic
+
+#include "./Maze.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 単一生産者・単一消費者 (SPSC) のロックフリーな壁情報キュー
+ * @details
+ * - センサ割り込みなどの生産者が push() で壁情報を積む
+ * - 計画タスクなどの消費者が drain() で迷路にまとめて反映する
+ * - push() はロックも動的メモリ確保も行わない (数回のストアのみ)
+ * - 生産者と消費者はそれぞれ単一であること
+ *
+ * ```
+ * WallRecordQueue<> queue;
+ * // センサ割り込み
+ * queue.push(p, d, b);
+ * // 計画タスク
+ * queue.drain(maze);
+ * stepMap.calcShortestDirections(maze, ...);
+ * ```
+ *
+ * @tparam N キューの容量。2のべき乗であること。
+ */
+template <int N = 64>
+class WallRecordQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+ public:
+  /** @brief キューの容量 */
+  static constexpr int SIZE = N;
+
+ public:
+  /**
+   * @brief 壁情報を追加する (生産者側)
+   * @param wr 壁情報
+   * @return true: 追加成功、false: キューが満杯で追加できなかった
+   */
+  bool push(const WallRecord wr) {
+    const auto h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == N) return false;
+    buffer[h & (N - 1)] = wr;
+    head.store(h + 1, std::memory_order_release);  //< 書き込み後に公開
+    return true;
+  }
+  bool push(const Position p, const Direction d, const bool b) {
+    return push(WallRecord(p, d, b));
+  }
+  /**
+   * @brief 壁情報をひとつ取り出す (消費者側)
+   * @param[out] wr 取り出した壁情報
+   * @return true: 取り出し成功、false: キューが空
+   */
+  bool pop(WallRecord& wr) {
+    const auto t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    wr = buffer[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);  //< 読み出し後に解放
+    return true;
+  }
+  /**
+   * @brief 溜まっている壁情報をすべて迷路に反映する (消費者側)
+   * @details 経路計画の直前に呼ぶことで、計画中の迷路の一貫性を保つ。
+   * 反映中に追加された壁情報は次回の drain() で反映される。
+   * @param maze 反映先の迷路
+   * @param pushRecords 壁更新の記録に追加する
+   * @return 反映した壁情報の数
+   */
+  int drain(Maze& maze, const bool pushRecords = true) {
+    const auto t = tail.load(std::memory_order_relaxed);
+    const auto h = head.load(std::memory_order_acquire);
+    for (auto i = t; i != h; ++i) {
+      const auto& wr = buffer[i & (N - 1)];
+      maze.updateWall(wr.getPosition(), wr.getDirection(), wr.b, pushRecords);
+    }
+    tail.store(h, std::memory_order_release);  //< まとめて解放
+    return h - t;
+  }
+  /**
+   * @brief 溜まっている壁情報の数 (消費者側)
+   */
+  int size() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_relaxed);
+  }
+  /**
+   * @brief キューが空かどうか (消費者側)
+   */
+  bool empty() const { return size() == 0; }
+
+ private:
+  std::array<WallRecord, N> buffer; /**< @brief リングバッファ */
+  std::atomic<uint32_t> head{0};    /**< @brief 書き込み位置 (生産者のみ更新) */
+  std::atomic<uint32_t> tail{0};    /**< @brief 読み出し位置 (消費者のみ更新) */
+};
+
+}  // namespace MazeLib
@@ -0,0 +1,84 @@
+/**
+ * @file WallValueEvaluator.h
+ * @brief 未知壁を確認する価値を並列に評価するクラスを定義
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#pragma once
+
+#include "./StepMap.h"
+#include "./ThreadPool.h"
+
+namespace MazeLib {
+
+/**
+ * @brief 未知壁ごとに、壁あり・壁なしを仮定した経路コストを並列に評価するクラス
+ * @details
+ * 次にどの未知壁を確認すべきかを決めるため、各未知壁について
+ * 壁ありと仮定した場合と壁なしと仮定した場合の最短経路のコストを求め、
+ * その差を確認する価値 (スコア) とする。
+ * - ワーカーごとに迷路の複製とステップマップを持ち、仮定ごとに使い回す
+ * - 仮定によってコストが変わりえない場合は、ステップマップを更新しない
+ *   - 現状で通過できる未知壁 (knownOnly=false で壁なし):
+ *     壁なしの仮定は現状と同じ。
+ *     壁ありの仮定は、現在の最短経路上の壁の場合のみ更新する
+ *   - 現状で通過できない未知壁 (knownOnly=true、または壁あり):
+ *     壁ありの仮定は現状と同じ。
+ *     壁なしの仮定は、壁の両側が目的地に到達不能な場合は更新しない
+ */
+class WallValueEvaluator {
+ public:
+  using step_t = StepMap::step_t; /**< @brief ステップの型 */
+
+  /**
+   * @brief 未知壁ひとつの評価結果
+   */
+  struct Result {
+    WallIndex i;         /**< @brief 評価した壁 */
+    step_t costIfWall;   /**< @brief 壁ありと仮定した場合の経路コスト */
+    step_t costIfNoWall; /**< @brief 壁なしと仮定した場合の経路コスト */
+    /**
+     * @brief 壁を確認する価値。仮定によるコストの差。
+     * @details 一方のみ経路がない場合は StepMap::STEP_MAX となる。
+     */
+    step_t score;
+  };
+
+ public:
+  /**
+   * @brief コンストラクタ
+   * @param pool 処理に使用するスレッドプール
+   */
+  explicit WallValueEvaluator(ThreadPool& pool)
+      : pool(pool), stepMaps(pool.size()), mazes(pool.size()) {}
+  /**
+   * @brief 指定した壁の価値を評価する
+   * @param[in] maze 使用する迷路
+   * @param[in] walls 評価する壁の集合
+   * @param[in] start 始点区画
+   * @param[in] dest 目的地区画の集合(順不同)
+   * @param[in] knownOnly 未知壁は壁ありとみなし、既知壁のみを使用する
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   * @return walls と同じ順の評価結果の配列
+   */
+  std::vector<Result> evaluate(const Maze& maze, const WallIndexes& walls,
+                               const Position start, const Positions& dest,
+                               const bool knownOnly, const bool simple);
+  /**
+   * @brief 迷路内のすべての未知壁について、スタートからゴールへの経路で評価する
+   * @param[in] maze 使用する迷路
+   * @param[in] knownOnly 未知壁は壁ありとみなし、既知壁のみを使用する
+   * @param[in] simple 台形加速を考慮せず、隣接区画のコストをすべて1にする
+   * @return 未知壁の評価結果の配列
+   */
+  std::vector<Result> evaluate(const Maze& maze, const bool knownOnly,
+                               const bool simple);
+
+ private:
+  ThreadPool& pool;              /**< @brief スレッドプール */
+  std::vector<StepMap> stepMaps; /**< @brief ワーカーごとのステップマップ */
+  std::vector<Maze> mazes;       /**< @brief ワーカーごとの迷路の複製 */
+};
+
+}  // namespace MazeLib
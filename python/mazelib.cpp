@@ -0,0 +1,310 @@
+/**
+ * @file mazelib.cpp
+ * @brief 迷路ライブラリの Python バインディング
+ * @details
+ * - 壁情報のビット列とステップマップは、コピーせずに NumPy 配列として参照する
+ * - 時間のかかる経路導出の呼び出し中は GIL を解放する
+ *
+ * ```py
+ * import numpy as np
+ * import mazelib
+ * maze = mazelib.Maze()
+ * maze.parse("mazedata/data/32MM2019HX.maze")
+ * step_map = mazelib.StepMap()
+ * dirs = step_map.calcShortestDirections(maze, False, False)
+ * walls = np.unpackbits(maze.wallBits, bitorder="little")
+ * steps = step_map.stepMap  # steps[x, y]
+ * ```
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <sstream>  //< for std::stringstream
+
+#include "MazeLib/BatchPlanner.h"
+#include "MazeLib/Maze.h"
+#include "MazeLib/StepMap.h"
+#include "MazeLib/ThreadPool.h"
+
+namespace py = pybind11;
+using namespace MazeLib;
+
+/**
+ * @brief 配列を読み取り専用にする
+ * @details 壁情報の書き換えは Maze のメソッドを経由させる。
+ */
+static py::array readonly(py::array a) {
+  a.attr("setflags")(py::arg("write") = false);
+  return a;
+}
+/**
+ * @brief 壁情報のビット列を、コピーせずに uint8 配列として参照する
+ * @details
+ * std::bitset が余分な領域を持たず、ワードの下位ビットから順に格納され、
+ * リトルエンディアンであることを仮定する (GCC, Clang の x86, ARM)。
+ * 壁 i は `np.unpackbits(a, bitorder="little")[i]` で参照できる。
+ * @param bits 参照するビット列
+ * @param base 配列が参照している間、生存させるオブジェクト
+ */
+static py::array bitsView(const std::bitset<WallIndex::SIZE>& bits,
+                          py::handle base) {
+  static_assert(sizeof(bits) * 8 == WallIndex::SIZE,
+                "std::bitset has padding!");
+  return readonly(py::array_t<uint8_t>(
+      {WallIndex::SIZE / 8}, {1}, reinterpret_cast<const uint8_t*>(&bits),
+      base));
+}
+/**
+ * @brief 結果の配列を、コピーせずに NumPy 配列として渡す
+ */
+template <typename T>
+static py::array_t<T> toArray(std::vector<T>&& v) {
+  auto p = new std::vector<T>(std::move(v));
+  py::capsule owner(p, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+  return py::array_t<T>({p->size()}, {sizeof(T)}, p->data(), owner);
+}
+/**
+ * @brief 標準出力へ表示する関数の出力を文字列として得る
+ */
+template <typename F>
+static std::string toString(const F& print) {
+  std::stringstream ss;
+  print(ss);
+  return ss.str();
+}
+
+PYBIND11_MODULE(mazelib, m) {
+  m.doc() = "MicroMouse Maze Library";
+  m.attr("MAZE_SIZE") = MAZE_SIZE;
+  m.attr("MAZE_SIZE_MAX") = MAZE_SIZE_MAX;
+
+  /* Direction */
+  py::class_<Direction> direction(m, "Direction");
+  direction.def(py::init<int8_t>(), py::arg("d") = 0)
+      .def("__int__", [](const Direction d) { return int(d); })
+      .def("__index__", [](const Direction d) { return int(d); })
+      .def("__eq__", [](const Direction a,
+                        const Direction b) { return int8_t(a) == int8_t(b); })
+      .def("__hash__", [](const Direction d) { return int(d); })
+      .def("__repr__",
+           [](const Direction d) { return std::string(1, d.toChar()); })
+      .def("isAlong", &Direction::isAlong)
+      .def("isDiag", &Direction::isDiag)
+      .def_static("Along4", &Direction::Along4)
+      .def_static("Diag4", &Direction::Diag4);
+  for (const auto& c :
+       {std::make_pair("East", Direction::East),
+        std::make_pair("NorthEast", Direction::NorthEast),
+        std::make_pair("North", Direction::North),
+        std::make_pair("NorthWest", Direction::NorthWest),
+        std::make_pair("West", Direction::West),
+        std::make_pair("SouthWest", Direction::SouthWest),
+        std::make_pair("South", Direction::South),
+        std::make_pair("SouthEast", Direction::SouthEast)})
+    direction.attr(c.first) = Direction(c.second);
+  for (const auto& c : {std::make_pair("Front", Direction::Front),
+                        std::make_pair("Left", Direction::Left),
+                        std::make_pair("Back", Direction::Back),
+                        std::make_pair("Right", Direction::Right)})
+    direction.attr(c.first) = Direction(c.second);
+  py::implicitly_convertible<py::int_, Direction>();
+
+  /* Position */
+  py::class_<Position>(m, "Position")
+      .def(py::init<int8_t, int8_t>(), py::arg("x") = 0, py::arg("y") = 0)
+      .def_property(
+          "x", [](const Position& p) { return p.x; },
+          [](Position& p, const int8_t x) { p.x = x; })
+      .def_property(
+          "y", [](const Position& p) { return p.y; },
+          [](Position& p, const int8_t y) { p.y = y; })
+      .def("getIndex", &Position::getIndex)
+      .def_static("getPositionFromIndex", &Position::getPositionFromIndex)
+      .def("next", &Position::next)
+      .def("isInsideOfField", &Position::isInsideOfField)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def("__hash__", [](const Position& p) { return p.data; })
+      .def("__repr__", [](const Position& p) { return p.toString(); });
+
+  /* PositionSet */
+  py::class_<PositionSet>(m, "PositionSet")
+      .def(py::init<>())
+      .def(py::init<const Positions&>(), py::arg("positions"))
+      .def("contains", &PositionSet::contains)
+      .def("insert", &PositionSet::insert)
+      .def("erase", &PositionSet::erase)
+      .def("clear", &PositionSet::clear)
+      .def("toPositions", &PositionSet::toPositions)
+      .def("__contains__", &PositionSet::contains)
+      .def("__len__", &PositionSet::size)
+      .def(
+          "__iter__",
+          [](const PositionSet& set) {
+            return py::make_iterator(set.begin(), set.end());
+          },
+          py::keep_alive<0, 1>())
+      .def(py::self == py::self)
+      .def(py::self != py::self);
+
+  /* WallIndex */
+  py::class_<WallIndex>(m, "WallIndex")
+      .def(py::init<Position, Direction>())
+      .def(py::init<uint16_t>())
+      .def_property_readonly("x", [](const WallIndex& i) { return i.x; })
+      .def_property_readonly("y", [](const WallIndex& i) { return int(i.y); })
+      .def_property_readonly("z", [](const WallIndex& i) { return int(i.z); })
+      .def("getIndex", &WallIndex::getIndex)
+      .def("getPosition", &WallIndex::getPosition)
+      .def("getDirection", &WallIndex::getDirection)
+      .def("isInsideOfField", &WallIndex::isInsideOfField)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def("__hash__", [](const WallIndex& i) { return i.data; });
+  m.attr("WallIndex").attr("SIZE") = WallIndex::SIZE;
+
+  /* Maze */
+  py::class_<Maze>(m, "Maze")
+      .def(py::init<const Positions&, const Position>(),
+           py::arg("goals") = Positions(), py::arg("start") = Position(0, 0))
+      .def("reset", &Maze::reset, py::arg("set_start_wall") = true,
+           py::arg("set_range_full") = false)
+      .def("isWall", py::overload_cast<const WallIndex>(&Maze::isWall,
+                                                        py::const_))
+      .def("isWall", py::overload_cast<const Position, const Direction>(
+                         &Maze::isWall, py::const_))
+      .def("isKnown", py::overload_cast<const WallIndex>(&Maze::isKnown,
+                                                         py::const_))
+      .def("isKnown", py::overload_cast<const Position, const Direction>(
+                          &Maze::isKnown, py::const_))
+      .def("setWall",
+           py::overload_cast<const WallIndex, const bool>(&Maze::setWall))
+      .def("setKnown",
+           py::overload_cast<const WallIndex, const bool>(&Maze::setKnown))
+      .def("updateWall", &Maze::updateWall, py::arg("p"), py::arg("d"),
+           py::arg("b"), py::arg("pushRecords") = true)
+      .def("parse", py::overload_cast<const std::string&>(&Maze::parse),
+           py::arg("filepath"))
+      .def("parseString",
+           [](Maze& maze, const std::string& data) {
+             std::istringstream is(data);
+             return maze.parse(is);
+           })
+      .def("getGoals", &Maze::getGoals)
+      .def("getGoalSet", &Maze::getGoalSet)
+      .def("setGoals", py::overload_cast<const Positions&>(&Maze::setGoals))
+      .def("setGoals", py::overload_cast<const PositionSet&>(&Maze::setGoals))
+      .def("getStart", &Maze::getStart)
+      .def("setStart", &Maze::setStart)
+      .def_property_readonly(
+          "wallBits",
+          [](py::object self) {
+            return bitsView(self.cast<const Maze&>().getWallBits(), self);
+          },
+          "壁情報のビット列 (uint8, 読み取り専用, コピーなし)")
+      .def_property_readonly(
+          "knownBits",
+          [](py::object self) {
+            return bitsView(self.cast<const Maze&>().getKnownBits(), self);
+          },
+          "既知未知情報のビット列 (uint8, 読み取り専用, コピーなし)")
+      .def("__str__", [](const Maze& maze) {
+        return toString([&](std::ostream& os) { maze.print(os); });
+      });
+
+  /* StepMap */
+  py::class_<StepMap>(m, "StepMap")
+      .def(py::init<>())
+      .def_property_readonly_static(
+          "STEP_MAX", [](py::object) { return StepMap::STEP_MAX; })
+      .def("getStep",
+           py::overload_cast<const Position>(&StepMap::getStep, py::const_))
+      .def_property_readonly(
+          "stepMap",
+          [](py::object self) {
+            const auto& a = self.cast<const StepMap&>().getMapArray();
+            using step_t = StepMap::step_t;
+            return readonly(py::array_t<step_t>(
+                {MAZE_SIZE_MAX, MAZE_SIZE_MAX},
+                {MAZE_SIZE_MAX * sizeof(step_t), sizeof(step_t)}, a.data(),
+                self));
+          },
+          "ステップマップ [x, y] (uint16, 読み取り専用, コピーなし)")
+      .def("update",
+           py::overload_cast<const Maze&, const Positions&, const bool,
+                             const bool>(&StepMap::update),
+           py::arg("maze"), py::arg("dest"), py::arg("knownOnly"),
+           py::arg("simple"), py::call_guard<py::gil_scoped_release>())
+      .def("update",
+           py::overload_cast<const Maze&, const PositionSet&, const bool,
+                             const bool>(&StepMap::update),
+           py::arg("maze"), py::arg("dest"), py::arg("knownOnly"),
+           py::arg("simple"), py::call_guard<py::gil_scoped_release>())
+      .def("updateBegin",
+           py::overload_cast<const Maze&, const Positions&, const bool,
+                             const bool>(&StepMap::updateBegin),
+           py::arg("maze"), py::arg("dest"), py::arg("knownOnly"),
+           py::arg("simple"), py::keep_alive<1, 2>())
+      .def("updateBegin",
+           py::overload_cast<const Maze&, const PositionSet&, const bool,
+                             const bool>(&StepMap::updateBegin),
+           py::arg("maze"), py::arg("dest"), py::arg("knownOnly"),
+           py::arg("simple"), py::keep_alive<1, 2>())
+      .def("updateResume", &StepMap::updateResume, py::arg("budget"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("isUpdating", &StepMap::isUpdating)
+      .def("getSettledStep", &StepMap::getSettledStep)
+      .def("isSettled", &StepMap::isSettled)
+      .def("calcShortestDirections",
+           py::overload_cast<const Maze&, const Position, const Positions&,
+                             const bool, const bool>(
+               &StepMap::calcShortestDirections),
+           py::arg("maze"), py::arg("start"), py::arg("dest"),
+           py::arg("knownOnly"), py::arg("simple"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("calcShortestDirections",
+           py::overload_cast<const Maze&, const bool, const bool>(
+               &StepMap::calcShortestDirections),
+           py::arg("maze"), py::arg("knownOnly"), py::arg("simple"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("toString", [](const StepMap& stepMap, const Maze& maze) {
+        return toString([&](std::ostream& os) {
+          stepMap.print(maze, Position(-1, -1), Direction::Max, os);
+        });
+      });
+
+  /* ThreadPool */
+  py::class_<ThreadPool>(m, "ThreadPool")
+      .def(py::init<int>(), py::arg("size") = 0)
+      .def("size", &ThreadPool::size);
+
+  /* BatchPlanner */
+  py::class_<BatchPlanner::Query>(m, "Query")
+      .def(py::init<Position, Positions>(), py::arg("start"), py::arg("dest"))
+      .def_readwrite("start", &BatchPlanner::Query::start)
+      .def_readwrite("dest", &BatchPlanner::Query::dest);
+  py::class_<BatchPlanner>(m, "BatchPlanner")
+      .def(py::init<ThreadPool&>(), py::arg("pool"), py::keep_alive<1, 2>())
+      .def("calcShortestDirections", &BatchPlanner::calcShortestDirections,
+           py::arg("maze"), py::arg("queries"), py::arg("knownOnly"),
+           py::arg("simple"), py::call_guard<py::gil_scoped_release>())
+      .def(
+          "calcSteps",
+          [](BatchPlanner& planner, const Maze& maze,
+             const std::vector<BatchPlanner::Query>& queries,
+             const bool knownOnly, const bool simple) {
+            std::vector<StepMap::step_t> steps;
+            {
+              py::gil_scoped_release release;
+              steps = planner.calcSteps(maze, queries, knownOnly, simple);
+            }
+            return toArray(std::move(steps));
+          },
+          py::arg("maze"), py::arg("queries"), py::arg("knownOnly"),
+          py::arg("simple"));
+}
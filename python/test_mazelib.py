@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# brief: Smoke Test for the Python bindings of MicroMouse Maze Library
+# author: Ryotaro Onuki <kerikun11+github@gmail.com>
+# date: 2026.10.17
+#
+# usage: PYTHONPATH=build/python python3 python/test_mazelib.py
+
+import threading
+import unittest
+
+import numpy as np
+
+import mazelib
+
+MAZE_DATA = """
++---+---+---+---+---+---+---+---+---+
+|               |                   |
++   +---+   +   +   +---+---+---+   +
+|       |   |   |   |               |
++---+   +   +   +   +   +---+---+---+
+|       |   |       |               |
++   +---+   +---+---+---+---+---+   +
+|       |   | G   G   G |           |
++---+   +   +   +   +   +   +---+---+
+|       |   | G   G   G |           |
++   +---+   +   +   +   +---+---+   +
+|       |   | G   G   G |       |   |
++---+   +   +   +---+---+   +   +   +
+|       |   |   |       |   |   |   |
++   +---+   +   +   +   +   +   +   +
+|       |   |   |   |   |   |   |   |
++   +   +   +   +   +   +   +   +   +
+|   | S |   |       |       |       |
++---+---+---+---+---+---+---+---+---+
+"""
+MAZE_SIZE = 9
+
+
+def parse():
+    maze = mazelib.Maze()
+    assert maze.parseString(MAZE_DATA)
+    return maze
+
+
+class TestMaze(unittest.TestCase):
+    def test_parse(self):
+        maze = parse()
+        self.assertEqual(maze.getStart(), mazelib.Position(1, 0))
+        goals = {(p.x, p.y) for p in maze.getGoals()}
+        self.assertEqual(goals, {(x, y) for x in range(3, 6) for y in range(3, 6)})
+        self.assertEqual(len(maze.getGoalSet()), 9)
+        self.assertIn(mazelib.Position(4, 4), maze.getGoalSet())
+
+    def test_wall_bits(self):
+        maze = parse()
+        bits = maze.wallBits
+        self.assertEqual(bits.dtype, np.uint8)
+        self.assertEqual(bits.shape, (mazelib.WallIndex.SIZE // 8,))
+        self.assertFalse(bits.flags.writeable)
+        walls = np.unpackbits(bits, bitorder="little")
+        for x in range(MAZE_SIZE):
+            for y in range(MAZE_SIZE):
+                for d in mazelib.Direction.Along4():
+                    i = mazelib.WallIndex(mazelib.Position(x, y), d)
+                    if i.isInsideOfField():
+                        self.assertEqual(bool(walls[i.getIndex()]), maze.isWall(i))
+        # the view is not a copy
+        i = mazelib.WallIndex(mazelib.Position(0, 1), mazelib.Direction.East)
+        maze.setWall(i, not maze.isWall(i))
+        walls = np.unpackbits(bits, bitorder="little")
+        self.assertEqual(bool(walls[i.getIndex()]), maze.isWall(i))
+
+
+class TestStepMap(unittest.TestCase):
+    def test_update(self):
+        maze = parse()
+        step_map = mazelib.StepMap()
+        step_map.update(maze, maze.getGoals(), True, True)
+        steps = step_map.stepMap
+        self.assertEqual(steps.dtype, np.uint16)
+        self.assertEqual(steps.shape, (mazelib.MAZE_SIZE_MAX, mazelib.MAZE_SIZE_MAX))
+        self.assertFalse(steps.flags.writeable)
+        for g in maze.getGoals():
+            self.assertEqual(steps[g.x, g.y], 0)
+        start = maze.getStart()
+        self.assertEqual(steps[start.x, start.y], step_map.getStep(start))
+        self.assertLess(step_map.getStep(start), mazelib.StepMap.STEP_MAX)
+        expected = steps.copy()
+        # the PositionSet overload gives the same map
+        step_map.update(maze, maze.getGoalSet(), True, True)
+        self.assertTrue(np.array_equal(steps, expected))
+        # the view is not a copy
+        step_map.update(maze, [start], True, True)
+        self.assertEqual(steps[start.x, start.y], 0)
+
+    def test_update_resume(self):
+        maze = parse()
+        expected = mazelib.StepMap()
+        expected.update(maze, maze.getGoals(), False, False)
+        step_map = mazelib.StepMap()
+        step_map.updateBegin(maze, maze.getGoalSet(), False, False)
+        while not step_map.updateResume(8):
+            pass
+        self.assertTrue(np.array_equal(step_map.stepMap, expected.stepMap))
+
+    def test_shortest_directions(self):
+        maze = parse()
+        dirs = mazelib.StepMap().calcShortestDirections(maze, True, False)
+        self.assertGreater(len(dirs), 0)
+
+
+class TestBatchPlanner(unittest.TestCase):
+    def test_calc_steps(self):
+        maze = parse()
+        queries = [
+            mazelib.Query(mazelib.Position(x, y), maze.getGoals())
+            for x in range(MAZE_SIZE)
+            for y in range(MAZE_SIZE)
+        ]
+        step_map = mazelib.StepMap()
+        step_map.update(maze, maze.getGoals(), True, True)
+        expected = [step_map.getStep(q.start) for q in queries]
+        planner = mazelib.BatchPlanner(mazelib.ThreadPool(2))
+        steps = planner.calcSteps(maze, queries, True, True)
+        self.assertIsInstance(steps, np.ndarray)
+        self.assertEqual(list(steps), expected)
+        # the call releases the GIL; run it from several threads at once
+        results = [None] * 4
+
+        def run(i):
+            results[i] = planner.calcSteps(maze, queries, True, True)
+
+        threads = [threading.Thread(target=run, args=(i,)) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for r in results:
+            self.assertEqual(list(r), expected)
+        dirs = planner.calcShortestDirections(maze, queries[:1], True, True)
+        self.assertEqual(len(dirs), 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
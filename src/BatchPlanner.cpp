@@ -0,0 +1,36 @@
+/**
+ * @file BatchPlanner.cpp
+ * @brief 多数の経路導出をスレッドプールでまとめて処理するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/BatchPlanner.h"
+
+namespace MazeLib {
+
+std::vector<Directions> BatchPlanner::calcShortestDirections(
+    const Maze& maze, const std::vector<Query>& queries, const bool knownOnly,
+    const bool simple) {
+  std::vector<Directions> results(queries.size());
+  pool.parallelFor(queries.size(), [&](const int worker, const int index) {
+    const auto& q = queries[index];
+    results[index] = stepMaps[worker].calcShortestDirections(
+        maze, q.start, q.dest, knownOnly, simple);
+  });
+  return results;
+}
+std::vector<StepMap::step_t> BatchPlanner::calcSteps(
+    const Maze& maze, const std::vector<Query>& queries, const bool knownOnly,
+    const bool simple) {
+  std::vector<StepMap::step_t> results(queries.size());
+  pool.parallelFor(queries.size(), [&](const int worker, const int index) {
+    const auto& q = queries[index];
+    auto& stepMap = stepMaps[worker];
+    stepMap.update(maze, q.dest, knownOnly, simple);
+    results[index] = stepMap.getStep(q.start);
+  });
+  return results;
+}
+
+}  // namespace MazeLib
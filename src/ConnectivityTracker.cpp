@@ -0,0 +1,136 @@
+/**
+ * @file ConnectivityTracker.cpp
+ * @brief 未知壁を通過可能とみなした迷路の連結性を逐次管理するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/ConnectivityTracker.h"
+
+#include <utility>  //< for std::swap
+
+namespace MazeLib {
+
+void ConnectivityTracker::update(const Maze& maze) {
+  known = maze.getKnownBits();
+  if (!initialized) {
+    wall = maze.getWallBits();
+    rebuild();
+    initialized = true;
+    return;
+  }
+  const auto changed = wall ^ maze.getWallBits();
+  if (changed.none()) return;
+  /* 変化した壁をひとつずつ反映する */
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    if (!changed[i]) continue;
+    const bool wasPassable = !wall[i];
+    wall[i] = !wall[i];
+    apply(WallIndex(i), wasPassable);
+  }
+}
+bool ConnectivityTracker::updateWall(Maze& maze, const Position p,
+                                     const Direction d, const bool b,
+                                     const bool pushRecords) {
+  const auto result = maze.updateWall(p, d, b, pushRecords);
+  update(maze);
+  return result;
+}
+WallIndexes ConnectivityTracker::getUnreachableUnknownWalls(
+    const Position p) const {
+  /* 未知壁の両側は同じ連結成分なので、壁の片側のみ調べればよい */
+  WallIndexes result;
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (!wi.isInsideOfField() || known[i]) continue;
+    if (!isReachable(p, wi.getPosition())) result.push_back(wi);
+  }
+  return result;
+}
+int ConnectivityTracker::getComponentCount() const {
+  int count = 0;
+  for (const auto s : sizes) count += s != 0;
+  return count;
+}
+void ConnectivityTracker::rebuild() {
+  labels.fill(Position::SIZE);
+  sizes.fill(0);
+  uint16_t label = 0;
+  Positions queue;
+  for (int i = 0; i < Position::SIZE; ++i) {
+    if (labels[i] != Position::SIZE) continue;
+    queue = {Position::getPositionFromIndex(i)};
+    labels[i] = label;
+    for (size_t head = 0; head < queue.size(); ++head) {
+      const auto p = queue[head];
+      for (const auto d : Direction::Along4()) {
+        if (!canGo(p, d)) continue;
+        const auto q = p.next(d);
+        if (labels[q.getIndex()] == label) continue;
+        labels[q.getIndex()] = label;
+        queue.push_back(q);
+      }
+    }
+    sizes[label++] = queue.size();
+  }
+}
+void ConnectivityTracker::apply(const WallIndex i, const bool wasPassable) {
+  if (!i.isInsideOfField()) return;
+  const auto a = i.getPosition();
+  const auto b = a.next(i.getDirection());
+  if (wasPassable)
+    split(a, b);
+  else
+    merge(a, b);
+}
+void ConnectivityTracker::split(const Position a, const Position b) {
+  /* 両側から交互に1区画ずつ探索し、出会えば連結のまま */
+  stamp += 2;
+  const uint32_t markA = stamp, markB = stamp + 1;
+  Positions queues[2] = {{a}, {b}};
+  size_t heads[2] = {0, 0};
+  marks[a.getIndex()] = markA;
+  marks[b.getIndex()] = markB;
+  for (int side = 0;; side ^= 1) {
+    auto& queue = queues[side];
+    /* 先に探索し尽くした側が分断された連結成分 */
+    if (heads[side] == queue.size()) break;
+    const auto p = queue[heads[side]++];
+    const auto mark = side ? markB : markA;
+    const auto other = side ? markA : markB;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto q = p.next(d);
+      if (marks[q.getIndex()] == other) return;
+      if (marks[q.getIndex()] == mark) continue;
+      marks[q.getIndex()] = mark;
+      queue.push_back(q);
+    }
+  }
+  /* 小さい側に新しい番号を付ける */
+  const auto& cells = heads[0] == queues[0].size() ? queues[0] : queues[1];
+  const auto from = labels[cells[0].getIndex()];
+  const auto to = getFreeLabel();
+  for (const auto p : cells) labels[p.getIndex()] = to;
+  sizes[from] -= cells.size();
+  sizes[to] = cells.size();
+  relabelCount += cells.size();
+}
+void ConnectivityTracker::merge(const Position a, const Position b) {
+  auto from = labels[a.getIndex()], to = labels[b.getIndex()];
+  if (from == to) return;
+  if (sizes[from] > sizes[to]) std::swap(from, to);
+  /* 小さい側の番号を付け替える */
+  for (auto& label : labels)
+    if (label == from) label = to;
+  relabelCount += sizes[from];
+  sizes[to] += sizes[from];
+  sizes[from] = 0;
+}
+uint16_t ConnectivityTracker::getFreeLabel() const {
+  for (int i = 0; i < Position::SIZE; ++i)
+    if (sizes[i] == 0) return i;
+  return Position::SIZE;  //< 起こらない (連結成分の数は区画数以下)
+}
+
+}  // namespace MazeLib
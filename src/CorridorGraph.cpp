@@ -0,0 +1,354 @@
+/**
+ * @file CorridorGraph.cpp
+ * @brief 通路を縮約したグラフで経路を導出するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/CorridorGraph.h"
+
+#include <algorithm>   //< for std::min, std::reverse
+#include <cstdlib>     //< for std::abs
+#include <functional>  //< for std::greater
+#include <queue>       //< for std::priority_queue
+
+namespace MazeLib {
+
+bool CorridorGraph::update(const Maze& maze, const bool knownOnly) {
+  /* 変化がなければ再構築しない */
+  if (built && this->knownOnly == knownOnly && wall == maze.getWallBits() &&
+      (!knownOnly || known == maze.getKnownBits()) &&
+      start == maze.getStart() && goals == maze.getGoals())
+    return false;
+  this->knownOnly = knownOnly;
+  wall = maze.getWallBits();
+  known = maze.getKnownBits();
+  start = maze.getStart();
+  goals = maze.getGoals();
+  build();
+  built = true;
+  return true;
+}
+void CorridorGraph::build() {
+  cells.fill({Pruned, Direction::Max, UNASSIGNED, 0});
+  nodes.clear();
+  edges.clear();
+  /* 移動可能な隣接区画の数 */
+  std::array<int8_t, Position::SIZE> degree{};
+  std::array<bool, Position::SIZE> terminal{};
+  std::array<bool, Position::SIZE> removed{};
+  for (int8_t x = 0; x < MAZE_SIZE; ++x)
+    for (int8_t y = 0; y < MAZE_SIZE; ++y)
+      for (const auto d : Direction::Along4())
+        degree[Position(x, y).getIndex()] += canGo(Position(x, y), d);
+  for (const auto p : goals)
+    if (p.isInsideOfField()) terminal[p.getIndex()] = true;
+  if (start.isInsideOfField()) terminal[start.getIndex()] = true;
+  /* 袋小路の枝刈り; 行き止まりから順に、分岐に達するまで取り除く */
+  Positions stack;
+  for (int8_t x = 0; x < MAZE_SIZE; ++x)
+    for (int8_t y = 0; y < MAZE_SIZE; ++y)
+      if (!terminal[Position(x, y).getIndex()] &&
+          degree[Position(x, y).getIndex()] <= 1)
+        stack.push_back(Position(x, y));
+  while (!stack.empty()) {
+    const auto p = stack.back();
+    stack.pop_back();
+    if (removed[p.getIndex()]) continue;
+    removed[p.getIndex()] = true;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto n = p.next(d);
+      const auto n_index = n.getIndex();
+      if (removed[n_index]) continue;
+      cells[p.getIndex()].to = d;  //< 残っている唯一の隣接区画が根元
+      if (--degree[n_index] <= 1 && !terminal[n_index]) stack.push_back(n);
+    }
+  }
+  /* 分岐、行き止まり、端点をノードとし、残りを通路とする */
+  const auto addNode = [&](const Position p) {
+    cells[p.getIndex()] = {Node, Direction::Max,
+                           static_cast<uint16_t>(nodes.size()), 0};
+    nodes.push_back(p);
+  };
+  keptCellCount = 0;
+  for (int8_t x = 0; x < MAZE_SIZE; ++x) {
+    for (int8_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      const auto i = p.getIndex();
+      if (removed[i]) continue;
+      ++keptCellCount;
+      if (terminal[i] || degree[i] != 2)
+        addNode(p);
+      else
+        cells[i].kind = Corridor;
+    }
+  }
+  /* ノードから通路をたどり、次のノードまでを辺とする */
+  const auto walk = [&](const uint16_t u) {
+    const auto pu = nodes[u];
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(pu, d)) continue;
+      auto p = pu.next(d);
+      if (removed[p.getIndex()]) continue;
+      const auto& c = cells[p.getIndex()];
+      if (c.kind == Node) {
+        if (u < c.id) edges.push_back({u, c.id, 1});  //< 隣接するノード
+        continue;
+      }
+      if (c.id != UNASSIGNED) continue;  //< 反対側から走査済み
+      const uint16_t e = edges.size();
+      step_t w = 1;
+      auto dir = d;
+      while (cells[p.getIndex()].kind == Corridor) {
+        cells[p.getIndex()].id = e;
+        cells[p.getIndex()].offset = w;
+        for (const auto nd : Direction::Along4()) {
+          if (nd == Direction(dir + Direction::Back) || !canGo(p, nd) ||
+              removed[p.next(nd).getIndex()])
+            continue;
+          dir = nd;
+          break;
+        }
+        p = p.next(dir);
+        ++w;
+      }
+      edges.push_back({u, cells[p.getIndex()].id, w});
+    }
+  };
+  for (uint16_t u = 0; u < nodes.size(); ++u) walk(u);
+  /* ノードを含まない環状の通路は、1区画をノードとする */
+  for (int8_t x = 0; x < MAZE_SIZE; ++x) {
+    for (int8_t y = 0; y < MAZE_SIZE; ++y) {
+      const auto p = Position(x, y);
+      const auto& c = cells[p.getIndex()];
+      if (c.kind != Corridor || c.id != UNASSIGNED) continue;
+      addNode(p);
+      walk(nodes.size() - 1);
+    }
+  }
+  /* 隣接リストの作成 (自己ループは最短経路に寄与しない) */
+  adjacency.assign(nodes.size(), {});
+  for (uint16_t i = 0; i < edges.size(); ++i) {
+    if (edges[i].u == edges[i].v) continue;
+    adjacency[edges[i].u].push_back(i);
+    adjacency[edges[i].v].push_back(i);
+  }
+}
+Position CorridorGraph::climb(Position p, step_t& depth) const {
+  while (cells[p.getIndex()].kind == Pruned &&
+         cells[p.getIndex()].to != Direction::Max)
+    p = p.next(cells[p.getIndex()].to), ++depth;
+  return p;
+}
+template <typename F>
+void CorridorGraph::forEachAttachment(Position p, step_t extra,
+                                      const F& f) const {
+  p = climb(p, extra);
+  const auto& c = cells[p.getIndex()];
+  if (c.kind == Node) {
+    f(c.id, extra);
+  } else if (c.kind == Corridor) {
+    const auto& e = edges[c.id];
+    f(e.u, extra + c.offset);
+    f(e.v, extra + e.w - c.offset);
+  }
+}
+Position CorridorGraph::findCommonAncestor(Position p, step_t dp, Position t,
+                                           step_t dt) const {
+  for (; dp > dt; --dp) p = p.next(cells[p.getIndex()].to);
+  for (; dt > dp; --dt) t = t.next(cells[t.getIndex()].to);
+  while (p != t) {
+    p = p.next(cells[p.getIndex()].to);
+    t = t.next(cells[t.getIndex()].to);
+  }
+  return p;
+}
+CorridorGraph::step_t CorridorGraph::calcLocalStep(const Position p,
+                                                   const Position t) const {
+  step_t dp = 0, dt = 0;
+  const auto ap = climb(p, dp);
+  const auto at = climb(t, dt);
+  if (ap == at) {
+    /* 同じ袋小路の木の中; 最も近い共通の祖先を経由する */
+    step_t da = 0;
+    climb(findCommonAncestor(p, dp, t, dt), da);
+    return dp + dt - 2 * da;
+  }
+  /* 同じ通路の中 */
+  const auto& cp = cells[ap.getIndex()];
+  const auto& ct = cells[at.getIndex()];
+  if (cp.kind == Corridor && ct.kind == Corridor && cp.id == ct.id)
+    return dp + dt + std::abs(cp.offset - ct.offset);
+  return STEP_MAX;
+}
+void CorridorGraph::calcDistances(const Positions& dest) {
+  using Element = std::pair<step_t, uint16_t>;
+  std::priority_queue<Element, std::vector<Element>, std::greater<Element>> q;
+  distances.assign(nodes.size(), STEP_MAX);
+  routes.assign(nodes.size(), {UNASSIGNED, Position(-1, -1)});
+  for (const auto t : dest) {
+    if (!t.isInsideOfField()) continue;
+    forEachAttachment(t, 0, [&](const uint16_t n, const step_t s) {
+      if (s < distances[n]) {
+        distances[n] = s;
+        routes[n] = {UNASSIGNED, t};
+        q.push({s, n});
+      }
+    });
+  }
+  while (!q.empty()) {
+    const auto s = q.top().first;
+    const auto u = q.top().second;
+    q.pop();
+    if (distances[u] < s) continue;
+    for (const auto i : adjacency[u]) {
+      const auto& e = edges[i];
+      const uint16_t v = e.u == u ? e.v : e.u;
+      const step_t next_s = s + e.w;
+      if (next_s < distances[v]) {
+        distances[v] = next_s;
+        routes[v] = {i, Position(-1, -1)};
+        q.push({next_s, v});
+      }
+    }
+  }
+}
+CorridorGraph::step_t CorridorGraph::calcStepFrom(
+    const Position p, const Positions& dest) const {
+  if (!p.isInsideOfField()) return STEP_MAX;
+  step_t best = STEP_MAX;
+  forEachAttachment(p, 0, [&](const uint16_t n, const step_t s) {
+    if (distances[n] != STEP_MAX)
+      best = std::min<step_t>(best, distances[n] + s);
+  });
+  for (const auto t : dest)
+    if (t.isInsideOfField()) best = std::min(best, calcLocalStep(p, t));
+  return best;
+}
+CorridorGraph::step_t CorridorGraph::calcStep(const Position start,
+                                              const Positions& dest) {
+  if (!built) return STEP_MAX;
+  calcDistances(dest);
+  return calcStepFrom(start, dest);
+}
+void CorridorGraph::appendClimb(Position p, const Position stop,
+                                Directions& dirs) const {
+  for (; p != stop; p = p.next(cells[p.getIndex()].to))
+    dirs.push_back(cells[p.getIndex()].to);
+}
+void CorridorGraph::appendCorridor(Position p, const bool towardU,
+                                   const Position stop,
+                                   Directions& dirs) const {
+  while (p != stop && cells[p.getIndex()].kind == Corridor) {
+    const auto& c = cells[p.getIndex()];
+    const auto& e = edges[c.id];
+    /* 辺の端ではノード、それ以外では隣の距離の通路へ進む */
+    const bool end = towardU ? c.offset == 1 : c.offset == e.w - 1;
+    const auto end_id = towardU ? e.u : e.v;
+    const step_t next_offset = towardU ? c.offset - 1 : c.offset + 1;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto& n = cells[p.next(d).getIndex()];
+      if (end ? (n.kind == Node && n.id == end_id)
+              : (n.kind == Corridor && n.id == c.id &&
+                 n.offset == next_offset)) {
+        dirs.push_back(d);
+        p = p.next(d);
+        break;
+      }
+    }
+  }
+}
+void CorridorGraph::appendAttachment(Position p, const uint16_t n,
+                                     const step_t s, Directions& dirs) const {
+  step_t depth = 0;
+  const auto a = climb(p, depth);
+  appendClimb(p, a, dirs);
+  const auto& c = cells[a.getIndex()];
+  if (c.kind != Corridor) return;  //< ノードに到着
+  /* 通路の両端が同じノードの場合もあるので、距離で向きを決める */
+  const auto& e = edges[c.id];
+  appendCorridor(a, e.u == n && depth + c.offset == s, nodes[n], dirs);
+}
+void CorridorGraph::appendEdge(const uint16_t n, const uint16_t i,
+                               Directions& dirs) const {
+  const auto& e = edges[i];
+  const bool forward = e.u == n;
+  const auto pm = nodes[forward ? e.v : e.u];
+  const auto pn = nodes[n];
+  for (const auto d : Direction::Along4()) {
+    if (!canGo(pn, d)) continue;
+    const auto q = pn.next(d);
+    const auto& c = cells[q.getIndex()];
+    if (e.w == 1 ? q == pm
+                 : (c.kind == Corridor && c.id == i &&
+                    c.offset == (forward ? 1 : e.w - 1))) {
+      dirs.push_back(d);
+      appendCorridor(q, !forward, pm, dirs);
+      return;
+    }
+  }
+}
+void CorridorGraph::appendLocal(const Position p, const Position t,
+                                Directions& dirs) const {
+  step_t dp = 0, dt = 0;
+  const auto ap = climb(p, dp);
+  const auto at = climb(t, dt);
+  /* 同じ袋小路の木の中では共通の祖先、同じ通路の中では通路を経由する */
+  const auto a = ap == at ? findCommonAncestor(p, dp, t, dt) : ap;
+  appendClimb(p, a, dirs);
+  if (ap != at) {
+    const auto& cp = cells[ap.getIndex()];
+    const auto& ct = cells[at.getIndex()];
+    appendCorridor(ap, ct.offset < cp.offset, at, dirs);
+  }
+  const auto from = dirs.size();
+  appendClimb(t, ap == at ? a : at, dirs);
+  reverseTail(dirs, from);
+}
+void CorridorGraph::reverseTail(Directions& dirs, const size_t from) {
+  std::reverse(dirs.begin() + from, dirs.end());
+  for (auto it = dirs.begin() + from; it != dirs.end(); ++it)
+    *it = Direction(*it + Direction::Back);
+}
+Directions CorridorGraph::calcShortestDirections(const Position start,
+                                                 const Positions& dest) {
+  if (!built || !start.isInsideOfField()) return {};
+  calcDistances(dest);
+  /* ノードを経由する経路と経由しない経路のうち、最も短いものを選ぶ */
+  step_t best = STEP_MAX, attachment = 0;
+  uint16_t first = UNASSIGNED;
+  Position target = Position(-1, -1);
+  forEachAttachment(start, 0, [&](const uint16_t n, const step_t s) {
+    if (distances[n] != STEP_MAX && distances[n] + s < best)
+      best = distances[n] + s, first = n, attachment = s;
+  });
+  for (const auto t : dest) {
+    if (!t.isInsideOfField()) continue;
+    const auto s = calcLocalStep(start, t);
+    if (s < best) best = s, first = UNASSIGNED, target = t;
+  }
+  if (best == STEP_MAX) return {};
+  Directions dirs;
+  dirs.reserve(best);
+  if (first == UNASSIGNED) {
+    appendLocal(start, target, dirs);
+    return dirs;
+  }
+  /* 始点からノードへ、ノードから目的地側の辺をたどる */
+  appendAttachment(start, first, attachment, dirs);
+  auto n = first;
+  while (routes[n].edge != UNASSIGNED) {
+    const auto i = routes[n].edge;
+    appendEdge(n, i, dirs);
+    n = edges[i].u == n ? edges[i].v : edges[i].u;
+  }
+  /* ノードから目的地へは、目的地からノードへの経路を逆にたどる */
+  const auto from = dirs.size();
+  appendAttachment(routes[n].target, n, distances[n], dirs);
+  reverseTail(dirs, from);
+  return dirs;
+}
+
+}  // namespace MazeLib
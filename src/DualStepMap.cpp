@@ -0,0 +1,132 @@
+/**
+ * @file DualStepMap.cpp
+ * @brief 既知壁のみと未知壁を通過可能とした2種類のステップを同時に求めるクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/DualStepMap.h"
+
+#include <algorithm>  //< for std::max
+
+namespace MazeLib {
+
+/* キューの要素の区画とレーンの集合の部分 */
+static_assert(2 * MAZE_SIZE_BIT + 2 <= 16, "Element must hold a position");
+static constexpr uint32_t ELEMENT_LANES_MASK = 3;
+static constexpr uint32_t ELEMENT_AXIS_MASK = MAZE_SIZE_MAX - 1;
+/* 区画、ステップ、レーンの集合をキューの要素に詰める */
+static uint32_t packElement(const Position p, const uint16_t s,
+                            const uint8_t lanes) {
+  return uint32_t(s) << 16 | uint32_t(p.y) << (MAZE_SIZE_BIT + 2) |
+         uint32_t(p.x) << 2 | lanes;
+}
+/* キューの要素から区画を取り出す */
+static Position unpackPosition(const uint32_t e) {
+  return Position(int8_t(e >> 2 & ELEMENT_AXIS_MASK),
+                  int8_t(e >> (MAZE_SIZE_BIT + 2) & ELEMENT_AXIS_MASK));
+}
+
+DualStepMap::DualStepMap() : stepTable(StepMap().getStepTable()) { reset(); }
+void DualStepMap::update(const Maze& maze, const PositionSet& dest,
+                         const bool simple) {
+  /* 計算を高速化するため、迷路の大きさを制限 (StepMap と同じ範囲) */
+  int8_t min_x, min_y, max_x, max_y;
+  StepMap::calcRange(maze, dest, min_x, min_y, max_x, max_y);
+  /* 全区画のステップを最大値に設定 */
+  reset();
+  auto& q = queue;
+  while (!q.empty()) q.pop();
+  counters = StepMap::Counters();
+  /* destのステップを0とする */
+  for (const auto p : dest) {
+    steps[p.getIndex()] = {0, 0};
+    q.push(packElement(p, 0, Known | Optimistic));
+  }
+  int relaxations = 0;
+  /* ステップの更新がなくなるまで更新処理 */
+  while (!q.empty()) {
+#if MAZE_STEP_MAP_COUNTERS
+    counters.queueSizeMax =
+        std::max(counters.queueSizeMax, static_cast<int>(q.size()));
+    ++counters.pops;
+#endif
+    /* 注目する区画を取得 */
+    const auto e = q.top();
+    q.pop();
+    const auto focus = unpackPosition(e);
+    const step_t focus_step = e >> 16;
+    uint8_t lanes = e & ELEMENT_LANES_MASK;
+    /* 計算を高速化するため展開範囲を制限 */
+    if (focus.x > max_x || focus.y > max_y || focus.x < min_x ||
+        focus.y < min_y)
+      continue;
+    /* 枝刈り; 後から更新されたレーンは別の要素で展開する */
+    const auto& focus_steps = steps[focus.getIndex()];
+    if (focus_steps.known != focus_step) lanes &= ~Known;
+    if (focus_steps.optimistic != focus_step) lanes &= ~Optimistic;
+    if (!lanes) continue;
+#if MAZE_STEP_MAP_COUNTERS
+    ++counters.expansions;
+#endif
+    /* 周辺を走査 */
+    for (const auto d : Direction::Along4()) {
+      auto next = focus;
+      auto walking = lanes;
+      int8_t i = 1;
+      /* 両方のレーンが同じステップで進む間は、直線の走査を共有する */
+      for (; walking == (Known | Optimistic); ++i) {
+        const auto next_wi = WallIndex(next, d);
+        /* 未知壁ならば、既知壁のみの側を打ち切る (この壁から再度走査) */
+        if (!maze.isKnown(next_wi)) {
+          walking = Optimistic;
+          break;
+        }
+        ++relaxations;
+        if (maze.isWall(next_wi)) {
+          walking = 0;
+          break;
+        }
+        next = next.next(d);  //< 移動
+        /* 直線加速を考慮したステップを算出 (両方のレーンで等しい) */
+        const step_t next_step = focus_step + (simple ? i : stepTable[i]);
+        auto& next_steps = steps[next.getIndex()];
+        /* 更新の必要がないレーンは打ち切る */
+        walking = 0;
+        if (next_steps.known > next_step)
+          next_steps.known = next_step, walking |= Known;
+        if (next_steps.optimistic > next_step)
+          next_steps.optimistic = next_step, walking |= Optimistic;
+        /* 再帰的に更新するためにキューにプッシュ */
+        if (walking) q.push(packElement(next, next_step, walking));
+#if MAZE_STEP_MAP_COUNTERS
+        if (walking) ++counters.pushes;
+#endif
+      }
+      if (!walking) continue;
+      /* 片方のレーンのみが進む場合は、StepMap と同じく走査する */
+      const bool known = walking == Known;
+      for (;; ++i) {
+        ++relaxations;
+        /* 壁あり or 既知壁のみで未知壁 ならば次へ */
+        const auto next_wi = WallIndex(next, d);
+        if (maze.isWall(next_wi) || (known && !maze.isKnown(next_wi))) break;
+        next = next.next(d);  //< 移動
+        /* 直線加速を考慮したステップを算出 */
+        const step_t next_step = focus_step + (simple ? i : stepTable[i]);
+        auto& next_steps = steps[next.getIndex()];
+        auto& step = known ? next_steps.known : next_steps.optimistic;
+        if (step <= next_step) break;  //< 更新の必要がない
+        step = next_step;              //< 更新
+        /* 再帰的に更新するためにキューにプッシュ */
+        q.push(packElement(next, next_step, walking));
+#if MAZE_STEP_MAP_COUNTERS
+        ++counters.pushes;
+#endif
+      }
+    }
+  }
+  counters.relaxations = relaxations;
+}
+
+}  // namespace MazeLib
@@ -0,0 +1,250 @@
+/**
+ * @file HierarchicalPlanner.cpp
+ * @brief 迷路をクラスタに分割して階層的に経路を導出するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/HierarchicalPlanner.h"
+
+#include <algorithm>   //< for std::min, std::reverse
+#include <cstdlib>     //< for std::abs
+#include <functional>  //< for std::greater
+#include <queue>       //< for std::priority_queue
+
+namespace MazeLib {
+
+HierarchicalPlanner::HierarchicalPlanner(const int clusterSize)
+    : clusterSize(std::max(1, clusterSize)),
+      clusterCount((MAZE_SIZE + this->clusterSize - 1) / this->clusterSize),
+      clusters(clusterCount * clusterCount) {
+  entranceIndex.fill(-1);
+}
+void HierarchicalPlanner::update(const Maze& maze, const bool knownOnly) {
+  if (!initialized || this->knownOnly != knownOnly) {
+    for (auto& c : clusters) c.dirty = true;
+  } else {
+    /* 変化した壁の両側のクラスタのみ無効化 */
+    auto changed = wall ^ maze.getWallBits();
+    if (knownOnly) changed |= known ^ maze.getKnownBits();
+    if (changed.any())
+      for (int i = 0; i < WallIndex::SIZE; ++i)
+        if (changed[i]) invalidate(WallIndex(i));
+  }
+  this->knownOnly = knownOnly;
+  wall = maze.getWallBits();
+  known = maze.getKnownBits();
+  initialized = true;
+}
+void HierarchicalPlanner::invalidate(const WallIndex i) {
+  if (!i.isInsideOfField()) return;
+  const auto p = i.getPosition();
+  clusters[getClusterId(p)].dirty = true;
+  const auto q = p.next(i.getDirection());
+  if (q.isInsideOfField()) clusters[getClusterId(q)].dirty = true;
+}
+const HierarchicalPlanner::Cluster& HierarchicalPlanner::getCluster(
+    const int id) {
+  auto& cluster = clusters[id];
+  if (!cluster.dirty) return cluster;
+  /* 境界を通過できる区画を入口とする */
+  cluster.entrances.clear();
+  const int8_t x0 = id / clusterCount * clusterSize;
+  const int8_t y0 = id % clusterCount * clusterSize;
+  const int8_t x1 = std::min(x0 + clusterSize, MAZE_SIZE);
+  const int8_t y1 = std::min(y0 + clusterSize, MAZE_SIZE);
+  for (int8_t x = x0; x < x1; ++x) {
+    for (int8_t y = y0; y < y1; ++y) {
+      const auto p = Position(x, y);
+      entranceIndex[p.getIndex()] = -1;
+      for (const auto d : Direction::Along4()) {
+        if (!canGo(p, d) || getClusterId(p.next(d)) == id) continue;
+        entranceIndex[p.getIndex()] = cluster.entrances.size();
+        cluster.entrances.push_back(p);
+        break;
+      }
+    }
+  }
+  /* 入口間のクラスタ内の距離 */
+  const int n = cluster.entrances.size();
+  cluster.costs.resize(n * n);
+  StepArray steps;
+  for (int i = 0; i < n; ++i) {
+    searchInCluster({cluster.entrances[i]}, steps);
+    for (int j = 0; j < n; ++j)
+      cluster.costs[i * n + j] = steps[cluster.entrances[j].getIndex()];
+  }
+  cluster.dirty = false;
+  ++rebuildCount;
+  return cluster;
+}
+void HierarchicalPlanner::searchInCluster(const Positions& sources,
+                                          StepArray& steps) const {
+  const int id = getClusterId(sources[0]);
+  const int8_t x0 = id / clusterCount * clusterSize;
+  const int8_t y0 = id % clusterCount * clusterSize;
+  const int8_t x1 = std::min(x0 + clusterSize, MAZE_SIZE);
+  const int8_t y1 = std::min(y0 + clusterSize, MAZE_SIZE);
+  for (int8_t x = x0; x < x1; ++x)
+    for (int8_t y = y0; y < y1; ++y)
+      steps[Position(x, y).getIndex()] = STEP_MAX;
+  Positions queue;
+  for (const auto p : sources) steps[p.getIndex()] = 0, queue.push_back(p);
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto p = queue[head];
+    const auto next_step = steps[p.getIndex()] + 1;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto q = p.next(d);
+      if (getClusterId(q) != id || steps[q.getIndex()] <= next_step) continue;
+      steps[q.getIndex()] = next_step;
+      queue.push_back(q);
+    }
+  }
+}
+void HierarchicalPlanner::refineInCluster(const Position src,
+                                          const Positions& dst,
+                                          Directions& dirs) const {
+  StepArray steps;
+  searchInCluster(dst, steps);
+  /* 距離が1ずつ減る隣接区画をたどる */
+  auto p = src;
+  while (steps[p.getIndex()] != 0 && steps[p.getIndex()] != STEP_MAX) {
+    const auto prev = p;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto q = p.next(d);
+      if (getClusterId(q) != getClusterId(p) ||
+          steps[q.getIndex()] + 1 != steps[p.getIndex()])
+        continue;
+      dirs.push_back(d);
+      p = q;
+      break;
+    }
+    if (p == prev) break;  //< 到達不能 (起こらない)
+  }
+}
+HierarchicalPlanner::step_t HierarchicalPlanner::searchRoute(
+    const Position start, const Positions& dest) {
+  route.clear();
+  if (!initialized || !start.isInsideOfField()) return STEP_MAX;
+  Positions goals;
+  for (const auto t : dest)
+    if (t.isInsideOfField()) goals.push_back(t);
+  if (goals.empty()) return STEP_MAX;
+  /* 目的地を含むクラスタの入口から、最寄りの目的地までの距離 */
+  StepArray goalSteps, steps;
+  goalSteps.fill(STEP_MAX);
+  std::vector<bool> visited(clusters.size());
+  for (const auto t : goals) {
+    const int id = getClusterId(t);
+    if (visited[id]) continue;
+    visited[id] = true;
+    Positions sources;
+    for (const auto s : goals)
+      if (getClusterId(s) == id) sources.push_back(s);
+    searchInCluster(sources, steps);
+    for (const auto e : getCluster(id).entrances)
+      goalSteps[e.getIndex()] = steps[e.getIndex()];
+  }
+  /* A* 探索; 節点は入口の区画と、仮想的な目的地 (GOAL) */
+  static constexpr int GOAL = Position::SIZE;
+  static constexpr int START = -1;
+  const auto heuristic = [&](const int node) {
+    if (node == GOAL) return 0;
+    const auto p = Position::getPositionFromIndex(node);
+    int h = STEP_MAX;
+    for (const auto t : goals)
+      h = std::min(h, std::abs(p.x - t.x) + std::abs(p.y - t.y));
+    return h;
+  };
+  std::vector<step_t> g(Position::SIZE + 1, STEP_MAX);
+  std::vector<int16_t> prev(Position::SIZE + 1, START);
+  using Element = std::pair<int, int>;  //< (f, node)
+  std::priority_queue<Element, std::vector<Element>, std::greater<Element>> q;
+  const auto relax = [&](const int node, const int cost, const int from) {
+    if (cost >= g[node]) return;
+    g[node] = cost;
+    prev[node] = from;
+    q.push({cost + heuristic(node), node});
+  };
+  /* 始点からクラスタ内で到達できる入口と目的地 */
+  const int startId = getClusterId(start);
+  searchInCluster({start}, steps);
+  for (const auto e : getCluster(startId).entrances)
+    if (steps[e.getIndex()] != STEP_MAX)
+      relax(e.getIndex(), steps[e.getIndex()], START);
+  for (const auto t : goals)
+    if (getClusterId(t) == startId && steps[t.getIndex()] != STEP_MAX)
+      relax(GOAL, steps[t.getIndex()], START);
+  while (!q.empty()) {
+    const auto f = q.top().first;
+    const auto u = q.top().second;
+    q.pop();
+    if (u == GOAL) break;
+    if (f > g[u] + heuristic(u)) continue;  //< 古い要素
+    const auto p = Position::getPositionFromIndex(u);
+    /* 目的地へ */
+    if (goalSteps[u] != STEP_MAX) relax(GOAL, g[u] + goalSteps[u], u);
+    /* クラスタ内の他の入口へ */
+    const auto& cluster = getCluster(getClusterId(p));
+    const int n = cluster.entrances.size();
+    const int i = entranceIndex[u];
+    for (int j = 0; j < n; ++j) {
+      const auto cost = cluster.costs[i * n + j];
+      if (j != i && cost != STEP_MAX)
+        relax(cluster.entrances[j].getIndex(), g[u] + cost, u);
+    }
+    /* 隣接クラスタの入口へ */
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d)) continue;
+      const auto next = p.next(d);
+      if (getClusterId(next) == getClusterId(p)) continue;
+      getCluster(getClusterId(next));  //< 入口の番号を確定させる
+      relax(next.getIndex(), g[u] + 1, u);
+    }
+  }
+  if (g[GOAL] == STEP_MAX) return STEP_MAX;
+  /* 抽象グラフ上の経路; 始点から最後の入口まで */
+  for (int node = prev[GOAL]; node != START; node = prev[node])
+    route.push_back(Position::getPositionFromIndex(node));
+  route.push_back(start);
+  std::reverse(route.begin(), route.end());
+  return g[GOAL];
+}
+HierarchicalPlanner::step_t HierarchicalPlanner::calcStep(
+    const Position start, const Positions& dest) {
+  return searchRoute(start, dest);
+}
+Directions HierarchicalPlanner::calcShortestDirections(const Position start,
+                                                       const Positions& dest) {
+  refinedClusterCount = 0;
+  if (searchRoute(start, dest) == STEP_MAX) return {};
+  /* 経路上のクラスタのみ詳細化する */
+  Directions dirs;
+  std::vector<bool> refined(clusters.size());
+  const auto refine = [&](const Position src, const Positions& dst) {
+    refineInCluster(src, dst, dirs);
+    const auto id = getClusterId(src);
+    refinedClusterCount += !refined[id];
+    refined[id] = true;
+  };
+  for (size_t i = 0; i + 1 < route.size(); ++i) {
+    const auto a = route[i], b = route[i + 1];
+    if (getClusterId(a) == getClusterId(b)) {
+      refine(a, {b});
+    } else {
+      for (const auto d : Direction::Along4())
+        if (a.next(d) == b) dirs.push_back(d);
+    }
+  }
+  /* 最後のクラスタ内の目的地へ */
+  Positions goals;
+  for (const auto t : dest)
+    if (t.isInsideOfField() && getClusterId(t) == getClusterId(route.back()))
+      goals.push_back(t);
+  refine(route.back(), goals);
+  return dirs;
+}
+
+}  // namespace MazeLib
@@ -0,0 +1,149 @@
+/**
+ * @file LandmarkPlanner.cpp
+ * @brief ランドマークによる下界を用いた A* 探索で経路を導出するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/LandmarkPlanner.h"
+
+#include <algorithm>   //< for std::find, std::max, std::min, std::reverse
+#include <functional>  //< for std::greater
+#include <queue>       //< for std::priority_queue
+#include <tuple>       //< for std::tuple
+
+namespace MazeLib {
+
+void LandmarkPlanner::setLandmarks(const Positions& landmarks) {
+  this->landmarks = landmarks;
+  valid = false;
+}
+bool LandmarkPlanner::update(const Maze& maze, const bool knownOnly) {
+  this->knownOnly = knownOnly;
+  wall = maze.getWallBits();
+  known = maze.getKnownBits();
+  /* 現在通過可能な壁 (迷路外の壁は常に通過不可能) */
+  auto now = ~wall;
+  if (knownOnly) now &= known;
+  /* 通過可能な壁が増えていなければ、下界は許容的なまま */
+  if (valid && (now & ~passable).none()) return false;
+  if (landmarks.empty()) {
+    Positions candidates = {Position(0, 0), Position(0, MAZE_SIZE - 1),
+                            Position(MAZE_SIZE - 1, 0),
+                            Position(MAZE_SIZE - 1, MAZE_SIZE - 1),
+                            maze.getStart()};
+    if (!maze.getGoals().empty()) candidates.push_back(maze.getGoals()[0]);
+    for (const auto p : candidates)
+      if (std::find(landmarks.begin(), landmarks.end(), p) == landmarks.end())
+        landmarks.push_back(p);
+  }
+  stepMaps.resize(landmarks.size());
+  for (size_t i = 0; i < landmarks.size(); ++i)
+    searchFrom(landmarks[i], stepMaps[i]);
+  passable = now;
+  valid = true;
+  ++refreshCount;
+  return true;
+}
+void LandmarkPlanner::searchFrom(const Position p, StepArray& steps) const {
+  steps.fill(STEP_MAX);
+  if (!p.isInsideOfField()) return;
+  Positions queue = {p};
+  steps[p.getIndex()] = 0;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto focus = queue[head];
+    const step_t next_step = steps[focus.getIndex()] + 1;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(focus, d)) continue;
+      const auto next = focus.next(d);
+      if (steps[next.getIndex()] <= next_step) continue;
+      steps[next.getIndex()] = next_step;
+      queue.push_back(next);
+    }
+  }
+}
+LandmarkPlanner::step_t LandmarkPlanner::getLowerBound(const Position u,
+                                                       const Position t) const {
+  step_t bound = 0;
+  for (const auto& s : stepMaps) {
+    const auto su = s[u.getIndex()], st = s[t.getIndex()];
+    /* 一方のみランドマークから到達できるなら、連結していない */
+    if ((su == STEP_MAX) != (st == STEP_MAX)) return STEP_MAX;
+    if (su == STEP_MAX) continue;
+    bound = std::max<step_t>(bound, su > st ? su - st : st - su);
+  }
+  return bound;
+}
+LandmarkPlanner::step_t LandmarkPlanner::search(const Position start,
+                                                const Positions& dest,
+                                                Position& end) {
+  expandedCount = 0;
+  if (!valid || !start.isInsideOfField()) return STEP_MAX;
+  Positions goals;
+  for (const auto t : dest)
+    if (t.isInsideOfField()) goals.push_back(t);
+  /* 最も近い目的地までの下界 */
+  const auto heuristic = [&](const Position p) {
+    step_t h = STEP_MAX;
+    for (const auto t : goals) h = std::min(h, getLowerBound(p, t));
+    return h;
+  };
+  std::array<bool, Position::SIZE> isGoal{};
+  for (const auto t : goals) isGoal[t.getIndex()] = true;
+  steps.fill(STEP_MAX);
+  /* f が等しければ、目的地に近い (h が小さい) 区画を優先する */
+  using Element = std::tuple<int, int, uint16_t>;  //< (f, h, index)
+  std::priority_queue<Element, std::vector<Element>, std::greater<Element>> q;
+  const auto h0 = heuristic(start);
+  if (h0 == STEP_MAX) return STEP_MAX;
+  steps[start.getIndex()] = 0;
+  from[start.getIndex()] = Direction::Max;
+  q.push({h0, h0, start.getIndex()});
+  while (!q.empty()) {
+    const auto f = std::get<0>(q.top());
+    const auto h = std::get<1>(q.top());
+    const auto focus = Position::getPositionFromIndex(std::get<2>(q.top()));
+    q.pop();
+    const auto focus_step = steps[focus.getIndex()];
+    /* 古い要素 (下界は一貫しているので、一度展開した区画は確定済み) */
+    if (f > focus_step + h) continue;
+    ++expandedCount;
+    if (isGoal[focus.getIndex()]) {
+      end = focus;
+      return focus_step;
+    }
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(focus, d)) continue;
+      const auto next = focus.next(d);
+      const step_t next_step = focus_step + 1;
+      if (steps[next.getIndex()] <= next_step) continue;
+      const auto next_h = heuristic(next);
+      if (next_h == STEP_MAX) continue;
+      steps[next.getIndex()] = next_step;
+      from[next.getIndex()] = d;
+      q.push({next_step + next_h, next_h, next.getIndex()});
+    }
+  }
+  return STEP_MAX;
+}
+LandmarkPlanner::step_t LandmarkPlanner::calcStep(const Position start,
+                                                  const Positions& dest) {
+  Position end;
+  return search(start, dest, end);
+}
+Directions LandmarkPlanner::calcShortestDirections(const Position start,
+                                                   const Positions& dest) {
+  Position end;
+  if (search(start, dest, end) == STEP_MAX) return {};
+  /* 目的地から進入方向を逆にたどる */
+  Directions dirs;
+  for (auto p = end; p != start;) {
+    const Direction d = from[p.getIndex()];
+    dirs.push_back(d);
+    p = p.next(d + Direction::Back);
+  }
+  std::reverse(dirs.begin(), dirs.end());
+  return dirs;
+}
+
+}  // namespace MazeLib
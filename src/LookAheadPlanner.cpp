@@ -0,0 +1,66 @@
+/**
+ * @file LookAheadPlanner.cpp
+ * @brief 走行中に次区画の経路を先読み計算するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/LookAheadPlanner.h"
+
+namespace MazeLib {
+
+void LookAheadPlanner::start(const Maze& maze, const Pose& next,
+                             const Positions& dest, const bool knownOnly,
+                             const bool simple) {
+  /* 前回の計算の完了を待つ */
+  for (auto& f : futures)
+    if (f.valid()) f.wait();
+  this->maze = maze;
+  this->next = next;
+  this->dest = dest;
+  this->knownOnly = knownOnly;
+  this->simple = simple;
+  /* 未知壁の組み合わせのみを計算する */
+  const auto dirs = getDirections();
+  unknownMask = 0;
+  for (int i = 0; i < 3; ++i)
+    if (!maze.isKnown(next.p, dirs[i])) unknownMask |= 1 << i;
+  for (int c = 0; c < CASE_SIZE; ++c) {
+    futures[c] = std::future<Directions>();
+    if (c & ~unknownMask) continue;  //< 既知壁を含む組み合わせは不要
+    std::array<bool, 3> walls;
+    for (int i = 0; i < 3; ++i)
+      walls[i] = (unknownMask & (1 << i)) ? (c >> i) & 1
+                                          : maze.isWall(next.p, dirs[i]);
+    futures[c] = std::async(std::launch::async, plan, std::cref(this->maze),
+                            next, std::cref(this->dest), knownOnly, simple,
+                            walls);
+  }
+}
+Directions LookAheadPlanner::get(const bool wallFront, const bool wallLeft,
+                                 const bool wallRight) {
+  const std::array<bool, 3> walls{{wallFront, wallLeft, wallRight}};
+  const auto dirs = getDirections();
+  /* 既知壁と食い違ったら、先読みは使えないのでその場で計算 */
+  int c = 0;
+  for (int i = 0; i < 3; ++i) {
+    if (unknownMask & (1 << i))
+      c |= walls[i] << i;
+    else if (maze.isWall(next.p, dirs[i]) != walls[i])
+      return plan(maze, next, dest, knownOnly, simple, walls);
+  }
+  return futures[c].valid() ? futures[c].get()
+                            : plan(maze, next, dest, knownOnly, simple, walls);
+}
+Directions LookAheadPlanner::plan(Maze maze, const Pose& next,
+                                  const Positions& dest, const bool knownOnly,
+                                  const bool simple,
+                                  const std::array<bool, 3>& walls) {
+  maze.updateWall(next.p, next.d + Direction::Front, walls[0], false);
+  maze.updateWall(next.p, next.d + Direction::Left, walls[1], false);
+  maze.updateWall(next.p, next.d + Direction::Right, walls[2], false);
+  StepMap stepMap;
+  return stepMap.calcShortestDirections(maze, next.p, dest, knownOnly, simple);
+}
+
+}  // namespace MazeLib
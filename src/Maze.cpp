@@ -7,102 +7,17 @@
  */
 #include "../include/MazeLib/Maze.h"
 
-#include <algorithm>  //< for std::find, std::count_if
-#include <iomanip>    //< for std::setw
+#include <algorithm>  //< for std::count_if
+#include <utility>    //< for std::swap
 
 namespace MazeLib {
 
-/* Direction */
-std::ostream& operator<<(std::ostream& os, const Directions& obj) {
-  for (const auto d : obj) os << d;
-  return os;
-}
-
-/* Position */
-Position Position::next(const Direction d) const {
-  switch (d) {
-    case Direction::East:
-      return Position(x + 1, y);
-    case Direction::NorthEast:
-      return Position(x + 1, y + 1);
-    case Direction::North:
-      return Position(x, y + 1);
-    case Direction::NorthWest:
-      return Position(x - 1, y + 1);
-    case Direction::West:
-      return Position(x - 1, y);
-    case Direction::SouthWest:
-      return Position(x - 1, y - 1);
-    case Direction::South:
-      return Position(x, y - 1);
-    case Direction::SouthEast:
-      return Position(x + 1, y - 1);
-    default:
-      MAZE_LOGE << d << std::endl;
-      return *this;
-  }
-}
-Position Position::rotate(const Direction d) const {
-  switch (d) {
-    case Direction::East:
-      return Position(x, y);
-    case Direction::North:
-      return Position(-y, x);
-    case Direction::West:
-      return Position(-x, -y);
-    case Direction::South:
-      return Position(y, -x);
-    default:
-      MAZE_LOGE << d << std::endl;
-      return *this;
-  }
-}
-std::ostream& operator<<(std::ostream& os, const Position p) {
-  return os << "( " << std::setw(2) << +p.x << ", " << std::setw(2) << +p.y
-            << ")";
-}
-
-/* Pose */
-std::ostream& operator<<(std::ostream& os, const Pose& pose) {
-  return os << "( " << std::setw(2) << +pose.p.x << ", " << std::setw(2)
-            << +pose.p.y << ", " << pose.d.toChar() << ")";
-}
-
-/* WallIndex */
-WallIndex WallIndex::next(const Direction d) const {
-  switch (d) {
-    case Direction::East:
-      return WallIndex(x + 1, y, z);
-    case Direction::NorthEast:
-      return WallIndex(x + 1 - z, y + z, 1 - z);
-    case Direction::North:
-      return WallIndex(x, y + 1, z);
-    case Direction::NorthWest:
-      return WallIndex(x - z, y + z, 1 - z);
-    case Direction::West:
-      return WallIndex(x - 1, y, z);
-    case Direction::SouthWest:
-      return WallIndex(x - z, y - 1 + z, 1 - z);
-    case Direction::South:
-      return WallIndex(x, y - 1, z);
-    case Direction::SouthEast:
-      return WallIndex(x + 1 - z, y - 1 + z, 1 - z);
-    default:
-      MAZE_LOGE << d << std::endl;
-      return WallIndex(x, y, z);
-  }
-}
-std::ostream& operator<<(std::ostream& os, const WallIndex i) {
-  return os << "( " << std::setw(2) << +i.x << ", " << std::setw(2) << +i.y
-            << ", " << i.getDirection().toChar() << ")";
-}
-
-/* WallRecord */
-std::ostream& operator<<(std::ostream& os, const WallRecord& obj) {
-  return os << "( " << std::setw(2) << +obj.x << ", " << std::setw(2) << +obj.y
-            << ", " << obj.getDirection().toChar() << ", "
-            << (obj.b ? "true" : "false") << ")";
-}
+#ifdef MAZE_IOSTREAM_DISABLED
+/* Log */
+static LogSink logSink = nullptr;
+void setLogSink(const LogSink sink) { logSink = sink; }
+LogSink getLogSink() { return logSink; }
+#endif
 
 /* Maze */
 void Maze::reset(const bool set_start_wall, const bool set_range_full) {
@@ -162,50 +77,191 @@ void Maze::resetLastWalls(const int num, const bool set_start_wall) {
     updateWall(wr.getPosition(), wr.getDirection(), wr.b);
   return;
 }
-bool Maze::parse(std::istream& is) {
-  /* determine the maze size */
-  /* get file size */
-  is.seekg(0, std::ios::end);  //< move the position to end
-  const int file_size = 1 + is.tellg();
-  is.seekg(0, std::ios::beg);  //< restore the position to begin
-  /* estimated (minimum) file size [byte] : F = (4*M + 1 + 1) * (2*M + 1) */
-  /* using quadratic formula, we have: M = (sqrt(2*F) - 2) / 4 */
-  const int mazeSize = (std::sqrt(2 * file_size) - 2) / 4;
-  if (mazeSize < 1) return false;  //< file size error
-  /* reset existing maze */
-  reset(), goals.clear();
-  char c;  //< temporal variable to use next
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    /* vertical walls and cells */
-    if (y != mazeSize) {
-      is.ignore(10, '|');  //< skip until next '|'
-      for (int8_t x = 0; x < mazeSize; ++x) {
-        is.ignore(1);  //< skip a space
-        c = is.get();
-        if (c == 'S')
-          start = Position(x, y);
-        else if (c == 'G')
-          goals.push_back(Position(x, y));
-        is.ignore(1);  //< skip a space
-        c = is.get();
-        if (c == '|')
-          Maze::updateWall(Position(x, y), Direction::East, true, false);
-        else if (c == ' ')
-          Maze::updateWall(Position(x, y), Direction::East, false, false);
+WallIndexes Maze::Diff::toWallIndexes(
+    const std::bitset<WallIndex::SIZE>& bits) {
+  WallIndexes result;
+  result.reserve(bits.count());
+  for (int i = 0; i < WallIndex::SIZE; ++i)
+    if (bits[i]) result.push_back(WallIndex(i));
+  return result;
+}
+int Maze::merge(const Maze& other, const MergePolicy policy,
+                const bool pushRecords) {
+  const auto d = diff(other);
+  /* 不一致のうち、この迷路の壁を変えるもの */
+  std::bitset<WallIndex::SIZE> resolved;
+  if (policy == TakeOther || policy == MarkUnknown) resolved = d.mismatched;
+  if (policy == PreferWall) resolved = d.mismatched & ~wall;
+  /* 未知壁は他の迷路の壁を採用 */
+  wall = (wall & ~d.unknown) | (other.wall & d.unknown);
+  known |= d.unknown;
+  /* 不一致の解決 */
+  switch (policy) {
+    case KeepThis:
+      break;
+    case TakeOther:
+    case PreferWall:
+      wall ^= resolved;
+      break;
+    case MarkUnknown:
+      wall &= ~resolved;
+      known &= ~resolved;
+      break;
+  }
+  /* 最大最小区画と壁ログの更新 (変化した壁のみ) */
+  const auto changed = d.unknown | resolved;
+  if (changed.any()) {
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      if (!changed[i]) continue;
+      const auto wi = WallIndex(i);
+      const auto p = wi.getPosition();
+      const auto dir = wi.getDirection();
+      if (known[i]) {
+        min_x = std::min(p.x, min_x);
+        min_y = std::min(p.y, min_y);
+        max_x = std::max(p.x, max_x);
+        max_y = std::max(p.y, max_y);
       }
+      if (!pushRecords) continue;
+      /*
+       * updateWall() で再生すると同じ状態になるように記録する。
+       * 不一致の壁は食い違う記録でいったん未知壁とし、
+       * 既知となる壁はその壁の有無を記録する。
+       */
+      if (resolved[i])
+        wallRecords.push_back(WallRecord(p, dir, other.wall[i]));
+      if (known[i]) wallRecords.push_back(WallRecord(p, dir, wall[i]));
     }
-    /* horizontal walls and pillars */
-    for (uint8_t x = 0; x < mazeSize; ++x) {
-      is >> c;  //< skip until next '+' or 'o'
-      std::string s;
-      for (int i = 0; i < 3; ++i) s += static_cast<char>(is.get());
-      if (s == "---")
-        Maze::updateWall(Position(x, y), Direction::South, true, false);
-      else if (s == "   ")
-        Maze::updateWall(Position(x, y), Direction::South, false, false);
+  }
+  return d.mismatched.count();
+}
+/* 壁のビット列の1行。行 y のビット x が区画 (x, y) の壁を表す */
+using Row = uint32_t;
+using Rows = std::array<Row, MAZE_SIZE_MAX>;
+static_assert(MAZE_SIZE_MAX <= 32, "Row must hold a line of walls");
+static constexpr int ROWS_PER_WORD = 64 / MAZE_SIZE_MAX;
+/* z の壁のビット列を 64 bit ずつ取り出して行に分ける */
+static Rows toRows(const std::bitset<WallIndex::SIZE>& bits, const int z) {
+  const std::bitset<WallIndex::SIZE> mask(~uint64_t(0));
+  const uint64_t rowMask = (uint64_t(1) << MAZE_SIZE_MAX) - 1;
+  Rows rows;
+  for (int k = 0; k < MAZE_SIZE_MAX / ROWS_PER_WORD; ++k) {
+    const int offset = z * Position::SIZE + 64 * k;
+    const uint64_t word = ((bits >> offset) & mask).to_ullong();
+    for (int j = 0; j < ROWS_PER_WORD; ++j)
+      rows[k * ROWS_PER_WORD + j] = (word >> (j * MAZE_SIZE_MAX)) & rowMask;
+  }
+  return rows;
+}
+/* 行を 64 bit ずつまとめて z の壁のビット列に書き込む */
+static void fromRows(std::bitset<WallIndex::SIZE>& bits, const Rows& rows,
+                     const int z) {
+  for (int k = 0; k < MAZE_SIZE_MAX / ROWS_PER_WORD; ++k) {
+    uint64_t word = 0;
+    for (int j = 0; j < ROWS_PER_WORD; ++j)
+      word |= uint64_t(rows[k * ROWS_PER_WORD + j]) << (j * MAZE_SIZE_MAX);
+    const int offset = z * Position::SIZE + 64 * k;
+    bits |= std::bitset<WallIndex::SIZE>(word) << offset;
+  }
+}
+/* ビット行列の転置。ブロックの入れ替えを log2(MAZE_SIZE_MAX) 回行う */
+static void transposeRows(Rows& a) {
+  Row m = (Row(1) << (MAZE_SIZE_MAX / 2)) - 1;
+  for (int j = MAZE_SIZE_MAX / 2; j > 0; j >>= 1, m ^= m << j) {
+    /* (k & j) == 0 の行 k について、行 k + j とブロックを入れ替える */
+    for (int k = 0; k < MAZE_SIZE_MAX; k = (k + j + 1) & ~j) {
+      const Row t = ((a[k] >> j) ^ a[k + j]) & m;
+      a[k] ^= t << j;
+      a[k + j] ^= t;
     }
   }
-  return true;
+}
+/* 行のビット反転 */
+static Row reverseRow(Row v) {
+  Row m = (Row(1) << (MAZE_SIZE_MAX / 2)) - 1;
+  for (int j = MAZE_SIZE_MAX / 2; j > 0; j >>= 1, m ^= m << j)
+    v = ((v >> j) & m) | ((v & m) << j);
+  return v;
+}
+/* 対角線 (x = y) についての鏡映。東の壁と北の壁が入れ替わる */
+static void transposeWalls(Rows& e, Rows& n) {
+  std::swap(e, n);
+  transposeRows(e);
+  transposeRows(n);
+}
+/* 1辺 size の範囲内での x 方向の鏡映。東の壁は西隣の区画の壁になる */
+static void mirrorWalls(Rows& e, Rows& n, const int size) {
+  for (int y = 0; y < MAZE_SIZE_MAX; ++y) {
+    e[y] = reverseRow(e[y]) >> (MAZE_SIZE_MAX - size + 1);
+    n[y] = reverseRow(n[y]) >> (MAZE_SIZE_MAX - size);
+  }
+}
+Maze Maze::transform(const int symmetry, const int size) const {
+  Maze result(Positions(), transformPosition(start, symmetry, size));
+  Positions newGoals;
+  for (const auto g : goals)
+    newGoals.push_back(transformPosition(g, symmetry, size));
+  result.setGoals(newGoals);
+  result.wall.reset();
+  result.known.reset();
+  result.wallRecords.clear();
+  /* 外周を除く範囲内の壁のみ変換する */
+  const auto lineMask = [](const int bits) {
+    return Row((uint64_t(1) << bits) - 1);
+  };
+  for (int i = 0; i < 2; ++i) {
+    const auto& src = i ? known : wall;
+    auto e = toRows(src, 0), n = toRows(src, 1);
+    for (int y = 0; y < MAZE_SIZE_MAX; ++y) {
+      e[y] &= y < size ? lineMask(size - 1) : 0;
+      n[y] &= y < size - 1 ? lineMask(size) : 0;
+    }
+    if (symmetry >= 4) transposeWalls(e, n);
+    /* 反時計回りの 90° 回転 = 対角線の鏡映 + x 方向の鏡映 */
+    for (int r = 0; r < symmetry % 4; ++r) {
+      transposeWalls(e, n);
+      mirrorWalls(e, n, size);
+    }
+    /* 外周の壁。迷路外の壁のビットは常に 0 とする */
+    if (size < MAZE_SIZE) {
+      for (int y = 0; y < size; ++y) e[y] |= Row(1) << (size - 1);
+      n[size - 1] |= lineMask(size);
+    }
+    auto& dst = i ? result.known : result.wall;
+    fromRows(dst, e, 0);
+    fromRows(dst, n, 1);
+  }
+  /* 最大最小区画 */
+  const auto clamp = [&](const int8_t v) {
+    return std::max<int8_t>(0, std::min<int8_t>(v, size - 1));
+  };
+  if (min_x <= max_x && min_y <= max_y) {
+    const auto a = transformPosition(Position(clamp(min_x), clamp(min_y)),
+                                     symmetry, size);
+    const auto b = transformPosition(Position(clamp(max_x), clamp(max_y)),
+                                     symmetry, size);
+    result.min_x = std::min(a.x, b.x);
+    result.min_y = std::min(a.y, b.y);
+    result.max_x = std::max(a.x, b.x);
+    result.max_y = std::max(a.y, b.y);
+  }
+  return result;
+}
+Position Maze::transformPosition(const Position p, const int symmetry,
+                                 const int size) {
+  int8_t x = p.x, y = p.y;
+  if (symmetry >= 4) std::swap(x, y);
+  for (int r = 0; r < symmetry % 4; ++r) {
+    const int8_t t = x;
+    x = size - 1 - y;
+    y = t;
+  }
+  return Position(x, y);
+}
+Direction Maze::transformDirection(const Direction d, const int symmetry) {
+  /* 対角線の鏡映は East と North、West と South を入れ替える */
+  const int8_t m = symmetry >= 4 ? Direction::North - d : int8_t(d);
+  return Direction(int8_t(m + Direction::North * (symmetry % 4)));
 }
 bool Maze::parse(const std::vector<std::string>& data, const int mazeSize) {
   for (const auto xr : {true, false}) {
@@ -258,178 +314,5 @@ bool Maze::parse(const std::vector<std::string>& data, const int mazeSize) {
   }
   return false;
 }
-void Maze::print(std::ostream& os, const int mazeSize) const {
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    if (y != mazeSize) {
-      os << '|';
-      for (int8_t x = 0; x < mazeSize; ++x) {
-        const auto p = Position(x, y);
-        if (p == start)
-          os << " S ";
-        else if (std::find(goals.cbegin(), goals.cend(), p) != goals.cend())
-          os << " G ";
-        else
-          os << "   ";
-        const auto k = isKnown(x, y, Direction::East);
-        const auto w = isWall(x, y, Direction::East);
-        os << (k ? (w ? '|' : ' ') : '.');
-      }
-      os << std::endl;
-    }
-    for (int8_t x = 0; x < mazeSize; ++x) {
-      const auto k = isKnown(x, y, Direction::South);
-      const auto w = isWall(x, y, Direction::South);
-      os << '+' << (k ? (w ? "---" : "   ") : " . ");
-    }
-    os << '+' << std::endl;
-  }
-}
-void Maze::print(const Directions& dirs, const Position start, std::ostream& os,
-                 const int mazeSize) const {
-  /* preparation */
-  std::vector<Pose> path;
-  path.reserve(dirs.size());
-  {
-    Position p = start;
-    for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
-  }
-  const auto& maze = *this;
-  /* start to draw maze */
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    if (y != mazeSize) {
-      for (uint8_t x = 0; x <= mazeSize; ++x) {
-        /* Vertical Wall */
-        const auto it =
-            std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
-              return WallIndex(pose.p, pose.d) ==
-                     WallIndex(Position(x, y), Direction::West);
-            });
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        if (it != path.cend())
-          os << C_YE << it->d << C_NO;
-        else
-          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Breaking Condition */
-        if (x == mazeSize) break;
-        /* Cell */
-        const auto p = Position(x, y);
-        if (p == start)
-          os << C_BL << " S " << C_NO;
-        else if (std::find(goals.cbegin(), goals.cend(), p) != goals.cend())
-          os << C_BL << " G " << C_NO;
-        else
-          os << "   ";
-      }
-      os << std::endl;
-    }
-    for (uint8_t x = 0; x < mazeSize; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto it =
-          std::find_if(path.cbegin(), path.cend(), [&](const Pose pose) {
-            return WallIndex(pose.p, pose.d) ==
-                   WallIndex(Position(x, y), Direction::South);
-          });
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      if (it != path.cend())
-        os << C_YE << ' ' << it->d << ' ' << C_NO;
-      else
-        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    /* Last Pillar */
-    os << '+' << std::endl;
-  }
-}
-void Maze::print(const Positions& positions, std::ostream& os,
-                 const int mazeSize) const {
-  /* preparation */
-  const auto exists = [&](const Position p) {
-    return std::find(positions.cbegin(), positions.cend(), p) !=
-           positions.cend();
-  };
-  const auto& maze = *this;
-  /* start to draw maze */
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    if (y != mazeSize) {
-      for (uint8_t x = 0; x <= mazeSize; ++x) {
-        /* Vertical Wall */
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Breaking Condition */
-        if (x == mazeSize) break;
-        /* Cell */
-        const auto p = Position(x, y);
-        if (p == start)
-          os << C_BL << " S " << C_NO;
-        else if (std::find(goals.cbegin(), goals.cend(), p) != goals.cend())
-          os << C_BL << " G " << C_NO;
-        else if (exists(p))
-          os << C_YE << " X " << C_NO;
-        else
-          os << "   ";
-      }
-      os << std::endl;
-    }
-    for (uint8_t x = 0; x < mazeSize; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    /* Last Pillar */
-    os << '+' << std::endl;
-  }
-}
-bool Maze::backupWallRecordsToFile(const std::string& filepath,
-                                   const bool clear) {
-  /* 変更なし */
-  if (!clear &&
-      wallRecordsBackupCounter == static_cast<int>(wallRecords.size()))
-    return true;
-  /* 前のデータが残っていたら削除 */
-  std::ifstream ifs(filepath, std::ios::ate);
-  const int num_items = ifs.tellg() / sizeof(WallRecord);
-  ifs.close();
-  if (clear || num_items > wallRecordsBackupCounter) {
-    std::remove(filepath.c_str());
-    wallRecordsBackupCounter = 0;
-  }
-  /* WallRecords を追記 */
-  std::ofstream ofs(filepath, std::ios::binary | std::ios::app);
-  if (ofs.fail()) {
-    MAZE_LOGW << "failed to open file! " << filepath << std::endl;
-    return false;
-  }
-  while (wallRecordsBackupCounter < static_cast<int>(wallRecords.size())) {
-    const auto& wr = wallRecords[wallRecordsBackupCounter];
-    ofs.write(reinterpret_cast<const char*>(&wr), sizeof(wr));
-    wallRecordsBackupCounter++;
-  }
-  return true;
-}
-bool Maze::restoreWallRecordsFromFile(const std::string& filepath) {
-  std::ifstream f(filepath, std::ios::binary);
-  if (f.fail()) {
-    MAZE_LOGW << "failed to open file! " << filepath << std::endl;
-    return false;
-  }
-  reset();
-  while (!f.eof()) {
-    WallRecord wr;
-    f.read(reinterpret_cast<char*>(&wr), sizeof(WallRecord));
-    Position p = Position(wr.x, wr.y);
-    Direction d = Direction(wr.d);
-    bool b = wr.b;
-    updateWall(p, d, b);
-    wallRecordsBackupCounter++;
-  }
-  return true;
-}
 
 }  // namespace MazeLib
@@ -0,0 +1,163 @@
+/**
+ * @file MazeGenerator.cpp
+ * @brief 性能評価用に迷路を自動生成するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/MazeGenerator.h"
+
+#include <algorithm>  //< for std::min, std::max
+
+namespace MazeLib {
+
+Maze MazeGenerator::generate(const Topology topology, const int size) {
+  const int n = std::min(std::max(2, size), MAZE_SIZE);
+  /* すべての壁を既知の壁にしてから掘る */
+  Maze maze;
+  maze.reset(false, true);
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (!wi.isInsideOfField()) continue;
+    maze.setWall(wi, true);
+    maze.setKnown(wi, true);
+  }
+  std::bitset<Position::SIZE> visited;
+  switch (topology) {
+    case Perfect:
+      carve(maze, n, visited);
+      maze.setGoals({Position(n - 1, n - 1)});
+      break;
+    case Braided:
+      carve(maze, n, visited);
+      braid(maze, n, 100, {});
+      maze.setGoals({Position(n - 1, n - 1)});
+      break;
+    case Open:
+      carve(maze, n, visited);
+      for (int i = 0; i < WallIndex::SIZE; ++i) {
+        const auto wi = WallIndex(i);
+        if (isRemovable(wi, n) && maze.isWall(wi) && chance(60))
+          maze.setWall(wi, false);
+      }
+      maze.setGoals({Position(n - 1, n - 1)});
+      break;
+    case Serpentine:
+      /* 列ごとに上下に往復する */
+      for (int8_t x = 0; x < n; ++x) {
+        for (int8_t y = 0; y + 1 < n; ++y)
+          maze.setWall(Position(x, y), Direction::North, false);
+        if (x + 1 < n)
+          maze.setWall(Position(x, x % 2 ? 0 : n - 1), Direction::East, false);
+      }
+      maze.setGoals({Position(n - 1, (n - 1) % 2 ? 0 : n - 1)});
+      break;
+    case Competition: {
+      /* 中央のゴール区画の部屋 (小さい迷路では隅の1区画で、部屋にしない) */
+      const int8_t side = n >= 6 ? 2 + n % 2 : 1;
+      const int8_t origin = n >= 6 ? (n - side) / 2 : n - 1;
+      Positions goals;
+      for (int8_t x = origin; x < origin + side; ++x)
+        for (int8_t y = origin; y < origin + side; ++y)
+          goals.push_back(Position(x, y));
+      if (side > 1)
+        for (const auto p : goals) visited[p.getIndex()] = true;
+      const auto room = visited;
+      carve(maze, n, visited);
+      braid(maze, n, 30, room);
+      maze.setGoals(goals);
+      if (side == 1) break;
+      /* 部屋の中の壁を取り除き、入口を1箇所だけ開ける */
+      WallIndexes entrances;
+      for (const auto p : goals) {
+        for (const auto d : Direction::Along4()) {
+          const auto wi = WallIndex(p, d);
+          if (!isRemovable(wi, n)) continue;
+          if (room[p.next(d).getIndex()])
+            maze.setWall(wi, false);
+          else
+            entrances.push_back(wi);
+        }
+      }
+      maze.setWall(entrances[uniform(entrances.size())], false);
+      break;
+    }
+    default:
+      break;
+  }
+  return maze;
+}
+#ifndef MAZE_IOSTREAM_DISABLED
+bool MazeGenerator::save(const Maze& maze, const std::string& filepath,
+                         const int size) {
+  std::ofstream ofs(filepath);
+  if (!ofs) return false;
+  maze.print(ofs, size);
+  return ofs.good();
+}
+#endif
+const char* MazeGenerator::getName(const Topology topology) {
+  static constexpr const char* names[TopologyMax] = {
+      "perfect", "braided", "open", "serpentine", "competition",
+  };
+  return topology < TopologyMax ? names[topology] : "unknown";
+}
+void MazeGenerator::carve(Maze& maze, const int size,
+                          std::bitset<Position::SIZE>& visited) {
+  /* スタート区画からは North のみに通じる */
+  const auto start = Position(0, 0);
+  maze.setWall(start, Direction::North, false);
+  visited[start.getIndex()] = true;
+  Positions stack = {start.next(Direction::North)};
+  visited[stack.back().getIndex()] = true;
+  while (!stack.empty()) {
+    const auto p = stack.back();
+    Directions dirs;
+    for (const auto d : Direction::Along4()) {
+      const auto q = p.next(d);
+      if (isRemovable(WallIndex(p, d), size) && !visited[q.getIndex()])
+        dirs.push_back(d);
+    }
+    if (dirs.empty()) {
+      stack.pop_back();
+      continue;
+    }
+    const auto d = dirs[uniform(dirs.size())];
+    maze.setWall(p, d, false);
+    visited[p.next(d).getIndex()] = true;
+    stack.push_back(p.next(d));
+  }
+}
+void MazeGenerator::braid(Maze& maze, const int size, const int percent,
+                          const std::bitset<Position::SIZE>& excluded) {
+  for (int8_t x = 0; x < size; ++x) {
+    for (int8_t y = 0; y < size; ++y) {
+      const auto p = Position(x, y);
+      if (excluded[p.getIndex()] || maze.wallCount(p) != 3) continue;
+      if (!chance(percent)) continue;
+      /* 隣も袋小路ならそちらを優先して通じさせる */
+      Directions dirs, deadEnds;
+      for (const auto d : Direction::Along4()) {
+        const auto q = p.next(d);
+        if (!maze.isWall(p, d) || !isRemovable(WallIndex(p, d), size) ||
+            excluded[q.getIndex()])
+          continue;
+        dirs.push_back(d);
+        if (maze.wallCount(q) == 3) deadEnds.push_back(d);
+      }
+      const auto& candidates = deadEnds.empty() ? dirs : deadEnds;
+      if (candidates.empty()) continue;
+      maze.setWall(p, candidates[uniform(candidates.size())], false);
+    }
+  }
+}
+bool MazeGenerator::isRemovable(const WallIndex i, const int size) {
+  if (!i.isInsideOfField()) return false;
+  const auto p = i.getPosition();
+  const auto q = p.next(i.getDirection());
+  /* スタート区画の East の壁は常にあり */
+  if (i == WallIndex(Position(0, 0), Direction::East)) return false;
+  return p.x < size && p.y < size && q.x < size && q.y < size;
+}
+
+}  // namespace MazeLib
@@ -0,0 +1,268 @@
+/**
+ * @file MazeIO.cpp
+ * @brief 迷路の表示、読み込み、ファイル保存など iostream を使う関数を定義
+ * @details MAZE_IOSTREAM_DISABLED が定義された構成では何も定義しない
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/Maze.h"
+
+#ifndef MAZE_IOSTREAM_DISABLED
+
+#include <algorithm>  //< for std::find_if
+#include <iomanip>    //< for std::setw
+
+namespace MazeLib {
+
+/* Direction */
+std::ostream& operator<<(std::ostream& os, const Directions& obj) {
+  for (const auto d : obj) os << d;
+  return os;
+}
+
+/* Position */
+std::ostream& operator<<(std::ostream& os, const Position p) {
+  return os << "( " << std::setw(2) << +p.x << ", " << std::setw(2) << +p.y
+            << ")";
+}
+
+/* Pose */
+std::ostream& operator<<(std::ostream& os, const Pose& pose) {
+  return os << "( " << std::setw(2) << +pose.p.x << ", " << std::setw(2)
+            << +pose.p.y << ", " << pose.d.toChar() << ")";
+}
+
+/* WallIndex */
+std::ostream& operator<<(std::ostream& os, const WallIndex i) {
+  return os << "( " << std::setw(2) << +i.x << ", " << std::setw(2) << +i.y
+            << ", " << i.getDirection().toChar() << ")";
+}
+
+/* WallRecord */
+std::ostream& operator<<(std::ostream& os, const WallRecord& obj) {
+  return os << "( " << std::setw(2) << +obj.x << ", " << std::setw(2) << +obj.y
+            << ", " << obj.getDirection().toChar() << ", "
+            << (obj.b ? "true" : "false") << ")";
+}
+/* Maze */
+bool Maze::parse(std::istream& is) {
+  /* determine the maze size */
+  /* get file size */
+  is.seekg(0, std::ios::end);  //< move the position to end
+  const int file_size = 1 + is.tellg();
+  is.seekg(0, std::ios::beg);  //< restore the position to begin
+  /* estimated (minimum) file size [byte] : F = (4*M + 1 + 1) * (2*M + 1) */
+  /* using quadratic formula, we have: M = (sqrt(2*F) - 2) / 4 */
+  const int mazeSize = (std::sqrt(2 * file_size) - 2) / 4;
+  if (mazeSize < 1) return false;  //< file size error
+  /* reset existing maze */
+  reset(), goals.clear();
+  char c;  //< temporal variable to use next
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    /* vertical walls and cells */
+    if (y != mazeSize) {
+      is.ignore(10, '|');  //< skip until next '|'
+      for (int8_t x = 0; x < mazeSize; ++x) {
+        is.ignore(1);  //< skip a space
+        c = is.get();
+        if (c == 'S')
+          start = Position(x, y);
+        else if (c == 'G')
+          goals.push_back(Position(x, y));
+        is.ignore(1);  //< skip a space
+        c = is.get();
+        if (c == '|')
+          Maze::updateWall(Position(x, y), Direction::East, true, false);
+        else if (c == ' ')
+          Maze::updateWall(Position(x, y), Direction::East, false, false);
+      }
+    }
+    /* horizontal walls and pillars */
+    for (uint8_t x = 0; x < mazeSize; ++x) {
+      is >> c;  //< skip until next '+' or 'o'
+      std::string s;
+      for (int i = 0; i < 3; ++i) s += static_cast<char>(is.get());
+      if (s == "---")
+        Maze::updateWall(Position(x, y), Direction::South, true, false);
+      else if (s == "   ")
+        Maze::updateWall(Position(x, y), Direction::South, false, false);
+    }
+  }
+  goalSet = PositionSet(goals);
+  return true;
+}
+void Maze::print(std::ostream& os, const int mazeSize) const {
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    if (y != mazeSize) {
+      os << '|';
+      for (int8_t x = 0; x < mazeSize; ++x) {
+        const auto p = Position(x, y);
+        if (p == start)
+          os << " S ";
+        else if (goalSet.contains(p))
+          os << " G ";
+        else
+          os << "   ";
+        const auto k = isKnown(x, y, Direction::East);
+        const auto w = isWall(x, y, Direction::East);
+        os << (k ? (w ? '|' : ' ') : '.');
+      }
+      os << std::endl;
+    }
+    for (int8_t x = 0; x < mazeSize; ++x) {
+      const auto k = isKnown(x, y, Direction::South);
+      const auto w = isWall(x, y, Direction::South);
+      os << '+' << (k ? (w ? "---" : "   ") : " . ");
+    }
+    os << '+' << std::endl;
+  }
+}
+void Maze::print(const Directions& dirs, const Position start, std::ostream& os,
+                 const int mazeSize) const {
+  /* preparation */
+  std::vector<Pose> path;
+  path.reserve(dirs.size());
+  {
+    Position p = start;
+    for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
+  }
+  const auto& maze = *this;
+  /* start to draw maze */
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    if (y != mazeSize) {
+      for (uint8_t x = 0; x <= mazeSize; ++x) {
+        /* Vertical Wall */
+        const auto it =
+            std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
+              return WallIndex(pose.p, pose.d) ==
+                     WallIndex(Position(x, y), Direction::West);
+            });
+        const auto w = maze.isWall(x, y, Direction::West);
+        const auto k = maze.isKnown(x, y, Direction::West);
+        if (it != path.cend())
+          os << C_YE << it->d << C_NO;
+        else
+          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
+        /* Breaking Condition */
+        if (x == mazeSize) break;
+        /* Cell */
+        const auto p = Position(x, y);
+        if (p == start)
+          os << C_BL << " S " << C_NO;
+        else if (goalSet.contains(p))
+          os << C_BL << " G " << C_NO;
+        else
+          os << "   ";
+      }
+      os << std::endl;
+    }
+    for (uint8_t x = 0; x < mazeSize; ++x) {
+      /* Pillar */
+      os << '+';
+      /* Horizontal Wall */
+      const auto it =
+          std::find_if(path.cbegin(), path.cend(), [&](const Pose pose) {
+            return WallIndex(pose.p, pose.d) ==
+                   WallIndex(Position(x, y), Direction::South);
+          });
+      const auto w = maze.isWall(x, y, Direction::South);
+      const auto k = maze.isKnown(x, y, Direction::South);
+      if (it != path.cend())
+        os << C_YE << ' ' << it->d << ' ' << C_NO;
+      else
+        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
+    }
+    /* Last Pillar */
+    os << '+' << std::endl;
+  }
+}
+void Maze::print(const Positions& positions, std::ostream& os,
+                 const int mazeSize) const {
+  /* preparation */
+  const auto exists = PositionSet(positions);
+  const auto& maze = *this;
+  /* start to draw maze */
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    if (y != mazeSize) {
+      for (uint8_t x = 0; x <= mazeSize; ++x) {
+        /* Vertical Wall */
+        const auto w = maze.isWall(x, y, Direction::West);
+        const auto k = maze.isKnown(x, y, Direction::West);
+        os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
+        /* Breaking Condition */
+        if (x == mazeSize) break;
+        /* Cell */
+        const auto p = Position(x, y);
+        if (p == start)
+          os << C_BL << " S " << C_NO;
+        else if (goalSet.contains(p))
+          os << C_BL << " G " << C_NO;
+        else if (exists.contains(p))
+          os << C_YE << " X " << C_NO;
+        else
+          os << "   ";
+      }
+      os << std::endl;
+    }
+    for (uint8_t x = 0; x < mazeSize; ++x) {
+      /* Pillar */
+      os << '+';
+      /* Horizontal Wall */
+      const auto w = maze.isWall(x, y, Direction::South);
+      const auto k = maze.isKnown(x, y, Direction::South);
+      os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
+    }
+    /* Last Pillar */
+    os << '+' << std::endl;
+  }
+}
+bool Maze::backupWallRecordsToFile(const std::string& filepath,
+                                   const bool clear) {
+  /* 変更なし */
+  if (!clear &&
+      wallRecordsBackupCounter == static_cast<int>(wallRecords.size()))
+    return true;
+  /* 前のデータが残っていたら削除 */
+  std::ifstream ifs(filepath, std::ios::ate);
+  const int num_items = ifs.tellg() / sizeof(WallRecord);
+  ifs.close();
+  if (clear || num_items > wallRecordsBackupCounter) {
+    std::remove(filepath.c_str());
+    wallRecordsBackupCounter = 0;
+  }
+  /* WallRecords を追記 */
+  std::ofstream ofs(filepath, std::ios::binary | std::ios::app);
+  if (ofs.fail()) {
+    MAZE_LOGW << "failed to open file! " << filepath << MAZE_LOG_ENDL;
+    return false;
+  }
+  while (wallRecordsBackupCounter < static_cast<int>(wallRecords.size())) {
+    const auto& wr = wallRecords[wallRecordsBackupCounter];
+    ofs.write(reinterpret_cast<const char*>(&wr), sizeof(wr));
+    wallRecordsBackupCounter++;
+  }
+  return true;
+}
+bool Maze::restoreWallRecordsFromFile(const std::string& filepath) {
+  std::ifstream f(filepath, std::ios::binary);
+  if (f.fail()) {
+    MAZE_LOGW << "failed to open file! " << filepath << MAZE_LOG_ENDL;
+    return false;
+  }
+  reset();
+  while (!f.eof()) {
+    WallRecord wr;
+    f.read(reinterpret_cast<char*>(&wr), sizeof(WallRecord));
+    Position p = Position(wr.x, wr.y);
+    Direction d = Direction(wr.d);
+    bool b = wr.b;
+    updateWall(p, d, b);
+    wallRecordsBackupCounter++;
+  }
+  return true;
+}
+
+}  // namespace MazeLib
+
+#endif  // MAZE_IOSTREAM_DISABLED
@@ -0,0 +1,94 @@
+/**
+ * @file MazeIndex.cpp
+ * @brief 探索途中の迷路と矛盾しない過去の迷路を検索する索引
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/MazeIndex.h"
+
+#include <algorithm>  //< for std::max
+
+namespace MazeLib {
+
+int MazeIndex::add(const Maze& maze, const int size, const std::string& name) {
+  const int id = names.size();
+  names.push_back(name);
+  /* 迷路内の壁。迷路外の壁はすべて壁ありとする */
+  std::bitset<WallIndex::SIZE> inside;
+  for (int8_t x = 0; x < size; ++x) {
+    for (int8_t y = 0; y < size; ++y) {
+      const auto p = Position(x, y);
+      for (const auto d : {Direction::East, Direction::North}) {
+        const auto q = p.next(d);
+        if (q.x >= size || q.y >= size) continue;
+        inside[WallIndex(p, d).getIndex()] = true;
+      }
+    }
+  }
+  for (int s = 0; s < SYMMETRY_SIZE; ++s) {
+    const auto wall = maze.transform(s, size).getWallBits() | ~inside;
+    const uint16_t v = variants.size();
+    variants.push_back(wall);
+    for (int i = 0; i < Position::SIZE; ++i) {
+      const auto p = Position::getPositionFromIndex(i);
+      postings[i * PATTERN_SIZE + getPattern(wall, p)].push_back(v);
+    }
+  }
+  return id;
+}
+#ifndef MAZE_IOSTREAM_DISABLED
+int MazeIndex::add(const std::string& filepath) {
+  Maze maze;
+  if (!maze.parse(filepath)) return -1;
+  const int size = std::max(maze.getMaxX(), maze.getMaxY()) + 1;
+  return add(maze, size, filepath.substr(filepath.find_last_of('/') + 1));
+}
+#endif
+std::vector<MazeIndex::Match> MazeIndex::find(const Maze& maze) const {
+  const auto& wall = maze.getWallBits();
+  const auto& known = maze.getKnownBits();
+  /* 4方向とも既知の区画のうち、最も候補の少ない区画の転置索引を使う */
+  const std::vector<uint16_t>* candidates = nullptr;
+  for (int i = 0; i < Position::SIZE; ++i) {
+    const auto p = Position::getPositionFromIndex(i);
+    bool complete = true;
+    for (const auto d : Direction::Along4()) {
+      const auto wi = WallIndex(p, d);
+      if (wi.isInsideOfField() && !known[wi.getIndex()]) complete = false;
+    }
+    if (!complete) continue;
+    const auto& list = postings[i * PATTERN_SIZE + getPattern(wall, p)];
+    if (!candidates || list.size() < candidates->size()) candidates = &list;
+  }
+  /* 既知壁がすべて一致するか確かめる */
+  std::vector<Match> matches;
+  const auto check = [&](const int v) {
+    if (((variants[v] ^ wall) & known).none())
+      matches.push_back({v / SYMMETRY_SIZE, uint8_t(v % SYMMETRY_SIZE)});
+  };
+  if (candidates)
+    for (const auto v : *candidates) check(v);
+  else
+    for (size_t v = 0; v < variants.size(); ++v) check(v);
+  return matches;
+}
+float MazeIndex::calcWallRatio(const std::vector<Match>& matches,
+                               const WallIndex i) const {
+  if (matches.empty()) return 0.5f;
+  if (!i.isInsideOfField()) return 1;
+  int count = 0;
+  for (const auto& m : matches) count += getWallBits(m)[i.getIndex()];
+  return float(count) / matches.size();
+}
+int MazeIndex::getPattern(const std::bitset<WallIndex::SIZE>& wall,
+                          const Position p) {
+  int pattern = 0;
+  for (const auto d : Direction::Along4()) {
+    const auto i = WallIndex(p, d);
+    pattern = pattern << 1 | (!i.isInsideOfField() || wall[i.getIndex()]);
+  }
+  return pattern;
+}
+
+}  // namespace MazeLib
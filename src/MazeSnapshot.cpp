@@ -0,0 +1,63 @@
+/**
+ * @file MazeSnapshot.cpp
+ * @brief 読み取り専用の迷路スナップショットを並行に公開するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/MazeSnapshot.h"
+
+#include <algorithm>  //< for std::min, std::remove_if
+
+namespace MazeLib {
+
+MazeSnapshots::Reader::Reader(MazeSnapshots& owner, const int id)
+    : epoch(owner.readerEpochs[id]) {
+  /* 版を読む前にエポックを宣言する (seq_cst により順序を保証) */
+  epoch.store(owner.epoch.load());
+  snapshot = owner.current.load();
+}
+MazeSnapshots::Reader::~Reader() { epoch.store(0); }
+
+MazeSnapshots::MazeSnapshots(const Maze& maze)
+    : owned(new Snapshot{maze, 0}) {
+  current.store(owned.get());
+}
+uint32_t MazeSnapshots::publish(const Maze& maze) {
+  /* 回収済みの版があれば再利用し、なければ確保する */
+  reclaim();
+  std::unique_ptr<Snapshot> next;
+  if (pool.empty()) {
+    next.reset(new Snapshot{maze, 0});
+  } else {
+    next = std::move(pool.back());
+    pool.pop_back();
+    next->maze = maze;
+  }
+  const auto version = owned->version + 1;
+  next->version = version;
+  /* 公開してから、古い版を現在のエポックで退避する */
+  current.store(next.get());
+  retired.emplace_back(epoch.fetch_add(1), std::move(owned));
+  owned = std::move(next);
+  return version;
+}
+int MazeSnapshots::reclaim() {
+  /* 読み込み中の最小エポック */
+  uint32_t min_epoch = epoch.load();
+  for (const auto& e : readerEpochs) {
+    const auto reader_epoch = e.load();
+    if (reader_epoch) min_epoch = std::min(min_epoch, reader_epoch);
+  }
+  /* 退避後に読み込みを開始した読み込み側しかいなければ回収できる */
+  const auto it =
+      std::remove_if(retired.begin(), retired.end(), [&](auto& r) {
+        if (r.first >= min_epoch) return false;
+        pool.push_back(std::move(r.second));
+        return true;
+      });
+  retired.erase(it, retired.end());
+  return retired.size();
+}
+
+}  // namespace MazeLib
@@ -0,0 +1,167 @@
+/**
+ * @file RegionPruner.cpp
+ * @brief 最短経路に含まれ得ない区画を枝刈りするクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/RegionPruner.h"
+
+#include <algorithm>  //< for std::min
+
+namespace MazeLib {
+
+void RegionPruner::update(const Maze& maze, const Position start,
+                          const Positions& dest, const int margin) {
+  wall = maze.getWallBits();
+  known = maze.getKnownBits();
+  irrelevant.reset();
+  stats = Stats();
+  knownCost = STEP_MAX;
+  Positions goals;
+  for (const auto t : dest)
+    if (t.isInsideOfField()) goals.push_back(t);
+  if (!start.isInsideOfField() || goals.empty()) {
+    irrelevant.set();
+    stats.unreachable = Position::SIZE;
+    return;
+  }
+  std::bitset<Position::SIZE> terminal;
+  terminal[start.getIndex()] = true;
+  for (const auto t : goals) terminal[t.getIndex()] = true;
+  /* 既知壁のみを通る経路の長さ (上界) */
+  StepArray fromStart, toDest;
+  searchFrom({start}, true, fromStart);
+  for (const auto t : goals)
+    knownCost = std::min(knownCost, fromStart[t.getIndex()]);
+  /* 到達不能な区画 */
+  searchFrom({start}, false, fromStart);
+  searchFrom(goals, false, toDest);
+  for (int i = 0; i < Position::SIZE; ++i) {
+    if (fromStart[i] != STEP_MAX && toDest[i] != STEP_MAX) continue;
+    irrelevant[i] = true;
+    ++stats.unreachable;
+  }
+  stats.deadEnd = pruneDeadEnds(terminal);
+  stats.articulation = pruneArticulations(start, terminal);
+  /* 遠回りの区画; 枝刈りした区画は単純路に含まれないので、距離は変わらない */
+  if (knownCost == STEP_MAX) return;
+  for (int i = 0; i < Position::SIZE; ++i) {
+    if (irrelevant[i] || fromStart[i] + toDest[i] <= knownCost + margin)
+      continue;
+    irrelevant[i] = true;
+    ++stats.detour;
+  }
+}
+void RegionPruner::seal(Maze& maze) const {
+  for (int i = 0; i < Position::SIZE; ++i) {
+    if (irrelevant[i]) continue;
+    const auto p = Position::getPositionFromIndex(i);
+    for (const auto d : Direction::Along4()) {
+      const auto q = p.next(d);
+      if (!q.isInsideOfField() || !irrelevant[q.getIndex()]) continue;
+      maze.setWall(p, d, true);
+      maze.setKnown(p, d, true);
+    }
+  }
+}
+void RegionPruner::searchFrom(const Positions& sources, const bool knownOnly,
+                              StepArray& steps) const {
+  steps.fill(STEP_MAX);
+  Positions queue = sources;
+  for (const auto p : sources) steps[p.getIndex()] = 0;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto p = queue[head];
+    const step_t next_step = steps[p.getIndex()] + 1;
+    for (const auto d : Direction::Along4()) {
+      if (!canGo(p, d, knownOnly)) continue;
+      const auto q = p.next(d);
+      if (steps[q.getIndex()] <= next_step) continue;
+      steps[q.getIndex()] = next_step;
+      queue.push_back(q);
+    }
+  }
+}
+int RegionPruner::pruneDeadEnds(const std::bitset<Position::SIZE>& terminal) {
+  /* 始点と目的地以外の次数1以下の区画を繰り返し除去 */
+  std::array<int8_t, Position::SIZE> degrees;
+  Positions queue;
+  for (int i = 0; i < Position::SIZE; ++i) {
+    if (irrelevant[i]) continue;
+    const auto p = Position::getPositionFromIndex(i);
+    degrees[i] = 0;
+    for (const auto d : Direction::Along4()) degrees[i] += canGo(p, d, false);
+    if (degrees[i] <= 1 && !terminal[i]) queue.push_back(p);
+  }
+  for (const auto p : queue) irrelevant[p.getIndex()] = true;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const auto p = queue[head];
+    for (const auto d : Direction::Along4()) {
+      const auto i = WallIndex(p, d);
+      if (!i.isInsideOfField() || wall[i.getIndex()]) continue;
+      const auto q = p.next(d);
+      if (irrelevant[q.getIndex()]) continue;
+      if (--degrees[q.getIndex()] > 1 || terminal[q.getIndex()]) continue;
+      irrelevant[q.getIndex()] = true;
+      queue.push_back(q);
+    }
+  }
+  return queue.size();
+}
+int RegionPruner::pruneArticulations(
+    const Position start, const std::bitset<Position::SIZE>& terminal) {
+  if (irrelevant[start.getIndex()]) return 0;
+  /* 始点を根とする深さ優先探索 (Tarjan の関節点の判定) */
+  std::array<int16_t, Position::SIZE> order, lowlink;
+  order.fill(-1);
+  std::array<Position, Position::SIZE> visited, parent;
+  std::bitset<Position::SIZE> hasTerminal = terminal;
+  struct Frame {
+    Position p;
+    int8_t d;
+  };
+  std::vector<Frame> stack = {{start, 0}};
+  std::vector<std::pair<int, int>> prunedRanges;  //< 訪問順の範囲
+  int time = 0;
+  order[start.getIndex()] = lowlink[start.getIndex()] = time;
+  visited[time++] = start;
+  while (!stack.empty()) {
+    const auto p = stack.back().p;
+    if (stack.back().d < 4) {
+      const auto d = Direction::Along4()[stack.back().d++];
+      if (!canGo(p, d, false)) continue;
+      const auto q = p.next(d);
+      if (order[q.getIndex()] < 0) {
+        order[q.getIndex()] = lowlink[q.getIndex()] = time;
+        visited[time++] = q;
+        parent[q.getIndex()] = p;
+        stack.push_back({q, 0});
+      } else if (p == start || q != parent[p.getIndex()]) {
+        lowlink[p.getIndex()] =
+            std::min(lowlink[p.getIndex()], order[q.getIndex()]);
+      }
+      continue;
+    }
+    stack.pop_back();
+    if (stack.empty()) break;
+    const auto u = stack.back().p;
+    lowlink[u.getIndex()] =
+        std::min(lowlink[u.getIndex()], lowlink[p.getIndex()]);
+    hasTerminal[u.getIndex()] =
+        hasTerminal[u.getIndex()] || hasTerminal[p.getIndex()];
+    /* u を通らずに出られず、始点も目的地も含まない部分木 */
+    if (lowlink[p.getIndex()] >= order[u.getIndex()] &&
+        !hasTerminal[p.getIndex()])
+      prunedRanges.push_back({order[p.getIndex()], time});
+  }
+  int count = 0;
+  for (const auto& range : prunedRanges) {
+    for (int i = range.first; i < range.second; ++i) {
+      count += !irrelevant[visited[i].getIndex()];
+      irrelevant[visited[i].getIndex()] = true;
+    }
+  }
+  return count;
+}
+
+}  // namespace MazeLib
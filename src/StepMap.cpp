@@ -9,8 +9,8 @@
 
 #include <algorithm>  //< for std::sort
 #include <cmath>      //< for std::sqrt
-#include <iomanip>    //< for std::setw
-#include <queue>
+
+#include "../include/MazeLib/ThreadPool.h"
 
 namespace MazeLib {
 
@@ -18,185 +18,92 @@ StepMap::StepMap() {
   calcStraightCostTable();
   reset();
 }
-void StepMap::print(const Maze& maze, const Position p, const Direction d,
-                    std::ostream& os) const {
-  return print(maze, {d}, p.next(d + Direction::Back), os);
-}
-void StepMap::print(const Maze& maze, const Directions& dirs,
-                    const Position start, std::ostream& os) const {
-  /* preparation */
-  std::vector<Pose> path;
-  path.reserve(dirs.size());
-  Position p = start;
-  for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
-  const int mazeSize = MAZE_SIZE;
-  step_t maxStep = 0;
-  for (const auto step : stepMap)
-    if (step != STEP_MAX) maxStep = std::max(maxStep, step);
-  const bool simple = (maxStep < 999);
-  const step_t scaler =
-      stepTable[stepTableSize - 1] - stepTable[stepTableSize - 2];
-  const auto find = [&](const WallIndex& i) {
-    return std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
-      return WallIndex(pose.p, pose.d) == i;
-    });
-  };
-  /* start to draw maze */
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    /* Vertical Wall Line */
-    if (y != mazeSize) {
-      for (uint8_t x = 0; x <= mazeSize; ++x) {
-        /* Vertical Wall */
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        const auto it = find(WallIndex(Position(x, y), Direction::West));
-        if (it != path.cend())
-          os << C_YE "\e[1m" << it->d << C_NO;
-        else
-          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Cell */
-        if (x != mazeSize) {
-          step_t step = getStep(x, y);
-          step = std::min(999, simple ? step : step / scaler);
-          os << (step == 0 ? C_YE : C_BL) << std::setw(3) << step << C_NO;
-        }
-      }
-      os << "\e[0K" << std::endl;  // clear from cursor position to end of line
-    }
-    /* Horizontal Wall Line */
-    for (uint8_t x = 0; x < mazeSize; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      const auto it = find(WallIndex(Position(x, y), Direction::South));
-      if (it != path.cend())
-        os << C_YE "\e[1m " << it->d << " " C_NO;
-      else
-        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
-    }
-    os << '+' << "\e[0K" << std::endl;
-  }
-}
-void StepMap::printFull(const Maze& maze, const Position p, const Direction d,
-                        std::ostream& os) const {
-  return printFull(maze, {d}, p.next(d + Direction::Back), os);
-}
-void StepMap::printFull(const Maze& maze, const Directions& dirs,
-                        const Position start, std::ostream& os) const {
-  /* preparation */
-  std::vector<Pose> path;
-  path.reserve(dirs.size());
-  Position p = start;
-  for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
-  const int mazeSize = MAZE_SIZE;
-  const auto find = [&](const WallIndex& i) {
-    return std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
-      return WallIndex(pose.p, pose.d) == i;
-    });
-  };
-  /* start to draw maze */
-  for (int8_t y = mazeSize; y >= 0; --y) {
-    /* Vertical Wall Line */
-    if (y != mazeSize) {
-      for (uint8_t x = 0; x <= mazeSize; ++x) {
-        /* Vertical Wall */
-        const auto w = maze.isWall(x, y, Direction::West);
-        const auto k = maze.isKnown(x, y, Direction::West);
-        const auto it = find(WallIndex(Position(x, y), Direction::West));
-        if (it != path.cend())
-          os << C_YE "\e[1m" << it->d << C_NO;
-        else
-          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
-        /* Cell */
-        if (x != mazeSize) {
-          auto step = std::min((step_t)99999, getStep(x, y));
-          os << (step == 0 ? C_YE : C_BL) << std::setw(5) << step << C_NO;
-        }
-      }
-      os << std::endl;
-    }
-    /* Horizontal Wall Line */
-    for (uint8_t x = 0; x < mazeSize; ++x) {
-      /* Pillar */
-      os << '+';
-      /* Horizontal Wall */
-      const auto w = maze.isWall(x, y, Direction::South);
-      const auto k = maze.isKnown(x, y, Direction::South);
-      const auto it = find(WallIndex(Position(x, y), Direction::South));
-      if (it != path.cend())
-        os << C_YE "\e[1m  " << it->d << "  " C_NO;
-      else
-        os << (k ? (w ? "-----" : "     ") : (C_RE "  .  " C_NO));
-    }
-    os << '+' << std::endl;
-  }
+void StepMap::calcRange(const Maze& maze, const PositionSet& dest,
+                        int8_t& min_x, int8_t& min_y, int8_t& max_x,
+                        int8_t& max_y) {
+  /* ゴールを含めないと導出不可能になる */
+  min_x = std::min(maze.getMinX(), dest.getMinX());
+  max_x = std::max(maze.getMaxX(), dest.getMaxX());
+  min_y = std::min(maze.getMinY(), dest.getMinY());
+  max_y = std::max(maze.getMaxY(), dest.getMaxY());
+  min_x -= 1, min_y -= 1, max_x += 2, max_y += 2;  //< 外周を許す
 }
-void StepMap::update(const Maze& maze, const Positions& dest,
+void StepMap::update(const Maze& maze, const PositionSet& dest,
                      const bool knownOnly, const bool simple) {
   MAZE_DEBUG_PROFILING_START(0)
-  /* 計算を高速化するため、迷路の大きさを制限 */
-  int8_t min_x = maze.getMinX();
-  int8_t max_x = maze.getMaxX();
-  int8_t min_y = maze.getMinY();
-  int8_t max_y = maze.getMaxY();
-  for (const auto p : dest) {  //< ゴールを含めないと導出不可能になる
-    min_x = std::min(p.x, min_x);
-    max_x = std::max(p.x, max_x);
-    min_y = std::min(p.y, min_y);
-    max_y = std::max(p.y, max_y);
+  /* 展開範囲が広ければ並列に更新 */
+  if (pool) {
+    int8_t min_x, min_y, max_x, max_y;
+    calcRange(maze, dest, min_x, min_y, max_x, max_y);
+    if ((max_x - min_x) * (max_y - min_y) > parallelThreshold)
+      return updateParallel(maze, dest, knownOnly, simple, *pool);
   }
-  min_x -= 1, min_y -= 1, max_x += 2, max_y += 2;  //< 外周を許す
+  /* 中断せずに最後まで更新 */
+  updateBegin(maze, dest, knownOnly, simple);
+  updateResume(std::numeric_limits<int>::max());
+  MAZE_DEBUG_PROFILING_END(0)
+}
+void StepMap::updateBegin(const Maze& maze, const PositionSet& dest,
+                          const bool knownOnly, const bool simple) {
+  /* 更新条件を保持 */
+  updateMaze = &maze;
+  updateKnownOnly = knownOnly;
+  updateSimple = simple;
+  /* 計算を高速化するため、迷路の大きさを制限 */
+  calcRange(maze, dest, updateMinX, updateMinY, updateMaxX, updateMaxY);
   /* 全区画のステップを最大値に設定 */
   reset();
-  /* ステップの更新予約のキュー */
-#define STEP_MAP_USE_PRIORITY_QUEUE 1
-#if STEP_MAP_USE_PRIORITY_QUEUE
-  struct Element {
-    Position p;
-    step_t s;
-    bool operator<(const Element& e) const { return s > e.s; }
-  };
-  std::priority_queue<Element> q;
-#else
-  std::queue<Position> q;
-#endif
+  /* 中断された更新が残っていれば破棄 (確保済みの領域は再利用) */
+  while (!queue.empty()) queue.pop();
+  counters = Counters();
   /* destのステップを0とする */
-  for (const auto p : dest)
-    if (p.isInsideOfField())
-#if STEP_MAP_USE_PRIORITY_QUEUE
-      setStep(p, 0), q.push({p, 0});
-#else
-      setStep(p, 0), q.push(p);
-#endif
+  for (const auto p : dest) setStep(p, 0), queue.push({p, 0});
+  if (!sourceMap.empty())
+    for (const auto p : dest) sourceMap[p.getIndex()] = p;
+}
+bool StepMap::updateResume(const int budget) {
+  if (!updateMaze) return true;
+  /* 更新条件を展開 */
+  const auto& maze = *updateMaze;
+  const auto knownOnly = updateKnownOnly;
+  const auto simple = updateSimple;
+  const auto min_x = updateMinX, min_y = updateMinY;
+  const auto max_x = updateMaxX, max_y = updateMaxY;
+  const bool labeling = !sourceMap.empty();
+  auto& q = queue;
+  int relaxations = 0;
   /* ステップの更新がなくなるまで更新処理 */
   while (!q.empty()) {
-#if MAZE_DEBUG_PROFILING
-    queueSizeMax = std::max(queueSizeMax, static_cast<int>(q.size()));
+    /* 予算を使い切ったら中断 */
+    if (relaxations >= budget) {
+      counters.relaxations += relaxations;
+      return false;
+    }
+#if MAZE_STEP_MAP_COUNTERS
+    counters.queueSizeMax =
+        std::max(counters.queueSizeMax, static_cast<int>(q.size()));
+    ++counters.pops;
 #endif
     /* 注目する区画を取得 */
-#if STEP_MAP_USE_PRIORITY_QUEUE
     const auto focus = q.top().p;
     const auto focus_step_q = q.top().s;
-#else
-    const auto focus = q.front();
-#endif
     q.pop();
     /* 計算を高速化するため展開範囲を制限 */
     if (focus.x > max_x || focus.y > max_y || focus.x < min_x ||
         focus.y < min_y)
       continue;
     const auto focus_step = stepMap[focus.getIndex()];
-#if STEP_MAP_USE_PRIORITY_QUEUE
     /* 枝刈り */
     if (focus_step < focus_step_q) continue;
+#if MAZE_STEP_MAP_COUNTERS
+    ++counters.expansions;
 #endif
     /* 周辺を走査 */
     for (const auto d : Direction::Along4()) {
       /* 直線で行けるところまで更新する */
       auto next = focus;
       for (int8_t i = 1;; ++i) {
+        ++relaxations;
         /* 壁あり or 既知壁のみで未知壁 ならば次へ */
         const auto next_wi = WallIndex(next, d);
         if (maze.isWall(next_wi) || (knownOnly && !maze.isKnown(next_wi)))
@@ -207,20 +114,128 @@ void StepMap::update(const Maze& maze, const Positions& dest,
         const auto next_index = next.getIndex();
         if (stepMap[next_index] <= next_step) break;  //< 更新の必要がない
         stepMap[next_index] = next_step;              //< 更新
+        if (labeling) sourceMap[next_index] = sourceMap[focus.getIndex()];
         /* 再帰的に更新するためにキューにプッシュ */
-#if STEP_MAP_USE_PRIORITY_QUEUE
         q.push({next, next_step});
-#else
-        q.push(next);
+#if MAZE_STEP_MAP_COUNTERS
+        ++counters.pushes;
 #endif
       }
     }
   }
-  MAZE_DEBUG_PROFILING_END(0)
+  counters.relaxations += relaxations;
+  updateMaze = nullptr;
+  return true;
+}
+void StepMap::updateParallel(const Maze& maze, const PositionSet& dest,
+                             const bool knownOnly, const bool simple,
+                             ThreadPool& pool) {
+  /* 中断された更新が残っていれば破棄 */
+  updateMaze = nullptr;
+  counters = Counters();
+  /* 計算を高速化するため、迷路の大きさを制限 */
+  int8_t min_x, min_y, max_x, max_y;
+  calcRange(maze, dest, min_x, min_y, max_x, max_y);
+  /* 全区画のステップを最大値に設定 */
+  reset();
+  /* ステップの更新予約のキュー */
+  std::priority_queue<Element> q;
+  /* destのステップを0とする */
+  for (const auto p : dest) setStep(p, 0), q.push({p, 0});
+  const bool labeling = !sourceMap.empty();
+  if (labeling)
+    for (const auto p : dest) sourceMap[p.getIndex()] = p;
+  /* 注目区画から直線で行けるところまでステップを算出し、更新を通知する */
+  const auto expand = [&](const Position focus, auto&& write) {
+    const auto focus_step = stepMap[focus.getIndex()];
+    for (const auto d : Direction::Along4()) {
+      auto next = focus;
+      for (int8_t i = 1;; ++i) {
+        const auto next_wi = WallIndex(next, d);
+        if (maze.isWall(next_wi) || (knownOnly && !maze.isKnown(next_wi)))
+          break;
+        next = next.next(d);
+        const step_t next_step = focus_step + (simple ? i : stepTable[i]);
+        if (stepMap[next.getIndex()] <= next_step) break;
+        write(next, next_step);
+      }
+    }
+  };
+  /* 逐次的な展開 (update() と同じ) */
+  const auto expandSequential = [&](const Position focus) {
+    expand(focus, [&](const Position next, const step_t next_step) {
+      stepMap[next.getIndex()] = next_step;
+      if (labeling) sourceMap[next.getIndex()] = sourceMap[focus.getIndex()];
+      q.push({next, next_step});
+    });
+  };
+  /* ワーカーごとの更新候補 */
+  struct Write {
+    Element e;
+    int focus;  //< 更新候補を出したバケット内の区画の番号
+  };
+  std::vector<std::vector<Write>> writes(pool.size());
+  /* 区画ごとの最後に更新候補になったバケットの番号と、候補を出した区画 */
+  std::array<uint32_t, Position::SIZE> written{};
+  std::array<int, Position::SIZE> writer;
+  uint32_t bucket_id = 0;
+  /* 同じステップの区画の集合 (バケット) ごとに展開 */
+  Positions bucket;
+  std::vector<bool> conflicted;
+  while (!q.empty()) {
+    /* バケットを取り出す。キューの順により区画の ID 順に並ぶ */
+    const auto bucket_step = q.top().s;
+    bucket.clear();
+    while (!q.empty() && q.top().s == bucket_step) {
+      const auto focus = q.top().p;
+      q.pop();
+      if (focus.x > max_x || focus.y > max_y || focus.x < min_x ||
+          focus.y < min_y)
+        continue;
+      if (stepMap[focus.getIndex()] < bucket_step) continue;  //< 枝刈り
+      bucket.push_back(focus);
+    }
+    /* 小さいバケットは逐次的に展開 */
+    if (static_cast<int>(bucket.size()) < parallelBucketMin) {
+      for (const auto focus : bucket) expandSequential(focus);
+      continue;
+    }
+    /* ステップマップを読み取り専用として、更新候補を並列に列挙 */
+    for (auto& w : writes) w.clear();
+    pool.parallelFor(bucket.size(), [&](const int worker, const int index) {
+      expand(bucket[index], [&](const Position next, const step_t next_step) {
+        writes[worker].push_back({{next, next_step}, index});
+      });
+    });
+    /* 同じ区画に更新候補を出した区画同士は、結果が展開順序に依存する */
+    ++bucket_id;
+    conflicted.assign(bucket.size(), false);
+    for (const auto& w : writes) {
+      for (const auto& e : w) {
+        const auto i = e.e.p.getIndex();
+        if (written[i] == bucket_id)
+          conflicted[writer[i]] = conflicted[e.focus] = true;
+        written[i] = bucket_id, writer[i] = e.focus;
+      }
+    }
+    /* 重複のない区画の更新候補は、そのまま逐次的な展開の結果と一致する */
+    for (const auto& w : writes) {
+      for (const auto& e : w) {
+        if (conflicted[e.focus]) continue;
+        stepMap[e.e.p.getIndex()] = e.e.s;
+        if (labeling)
+          sourceMap[e.e.p.getIndex()] = sourceMap[bucket[e.focus].getIndex()];
+        q.push(e.e);
+      }
+    }
+    /* 重複のある区画は update() と同じ順序で逐次的に展開 */
+    for (size_t i = 0; i < bucket.size(); ++i)
+      if (conflicted[i]) expandSequential(bucket[i]);
+  }
 }
 Directions StepMap::calcShortestDirections(const Maze& maze,
                                            const Position start,
-                                           const Positions& dest,
+                                           const PositionSet& dest,
                                            const bool knownOnly,
                                            const bool simple) {
   /* ステップマップを更新 */
@@ -429,7 +444,7 @@ void StepMap::calcStraightCostTable() {
   for (int i = 0; i < stepTableSize; ++i) {
     stepTable[i] /= scalingFactor;
 #if 0
-    MAZE_LOGI << "stepTable[" << i << "]:\t" << stepTable[i] << std::endl;
+    MAZE_LOGI << "stepTable[" << i << "]:\t" << stepTable[i] << MAZE_LOG_ENDL;
 #endif
   }
 }
@@ -0,0 +1,136 @@
+/**
+ * @file StepMapIO.cpp
+ * @brief ステップマップの表示を定義
+ * @details MAZE_IOSTREAM_DISABLED が定義された構成では何も定義しない
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/StepMap.h"
+
+#ifndef MAZE_IOSTREAM_DISABLED
+
+#include <algorithm>  //< for std::find_if, std::min, std::max
+#include <iomanip>    //< for std::setw
+
+namespace MazeLib {
+
+void StepMap::print(const Maze& maze, const Position p, const Direction d,
+                    std::ostream& os) const {
+  return print(maze, {d}, p.next(d + Direction::Back), os);
+}
+void StepMap::print(const Maze& maze, const Directions& dirs,
+                    const Position start, std::ostream& os) const {
+  /* preparation */
+  std::vector<Pose> path;
+  path.reserve(dirs.size());
+  Position p = start;
+  for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
+  const int mazeSize = MAZE_SIZE;
+  step_t maxStep = 0;
+  for (const auto step : stepMap)
+    if (step != STEP_MAX) maxStep = std::max(maxStep, step);
+  const bool simple = (maxStep < 999);
+  const step_t scaler =
+      stepTable[stepTableSize - 1] - stepTable[stepTableSize - 2];
+  const auto find = [&](const WallIndex& i) {
+    return std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
+      return WallIndex(pose.p, pose.d) == i;
+    });
+  };
+  /* start to draw maze */
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    /* Vertical Wall Line */
+    if (y != mazeSize) {
+      for (uint8_t x = 0; x <= mazeSize; ++x) {
+        /* Vertical Wall */
+        const auto w = maze.isWall(x, y, Direction::West);
+        const auto k = maze.isKnown(x, y, Direction::West);
+        const auto it = find(WallIndex(Position(x, y), Direction::West));
+        if (it != path.cend())
+          os << C_YE "\e[1m" << it->d << C_NO;
+        else
+          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
+        /* Cell */
+        if (x != mazeSize) {
+          step_t step = getStep(x, y);
+          step = std::min(999, simple ? step : step / scaler);
+          os << (step == 0 ? C_YE : C_BL) << std::setw(3) << step << C_NO;
+        }
+      }
+      os << "\e[0K" << std::endl;  // clear from cursor position to end of line
+    }
+    /* Horizontal Wall Line */
+    for (uint8_t x = 0; x < mazeSize; ++x) {
+      /* Pillar */
+      os << '+';
+      /* Horizontal Wall */
+      const auto w = maze.isWall(x, y, Direction::South);
+      const auto k = maze.isKnown(x, y, Direction::South);
+      const auto it = find(WallIndex(Position(x, y), Direction::South));
+      if (it != path.cend())
+        os << C_YE "\e[1m " << it->d << " " C_NO;
+      else
+        os << (k ? (w ? "---" : "   ") : (C_RE " . " C_NO));
+    }
+    os << '+' << "\e[0K" << std::endl;
+  }
+}
+void StepMap::printFull(const Maze& maze, const Position p, const Direction d,
+                        std::ostream& os) const {
+  return printFull(maze, {d}, p.next(d + Direction::Back), os);
+}
+void StepMap::printFull(const Maze& maze, const Directions& dirs,
+                        const Position start, std::ostream& os) const {
+  /* preparation */
+  std::vector<Pose> path;
+  path.reserve(dirs.size());
+  Position p = start;
+  for (const auto d : dirs) path.push_back({p, d}), p = p.next(d);
+  const int mazeSize = MAZE_SIZE;
+  const auto find = [&](const WallIndex& i) {
+    return std::find_if(path.cbegin(), path.cend(), [&](const Pose& pose) {
+      return WallIndex(pose.p, pose.d) == i;
+    });
+  };
+  /* start to draw maze */
+  for (int8_t y = mazeSize; y >= 0; --y) {
+    /* Vertical Wall Line */
+    if (y != mazeSize) {
+      for (uint8_t x = 0; x <= mazeSize; ++x) {
+        /* Vertical Wall */
+        const auto w = maze.isWall(x, y, Direction::West);
+        const auto k = maze.isKnown(x, y, Direction::West);
+        const auto it = find(WallIndex(Position(x, y), Direction::West));
+        if (it != path.cend())
+          os << C_YE "\e[1m" << it->d << C_NO;
+        else
+          os << (k ? (w ? "|" : " ") : (C_RE "." C_NO));
+        /* Cell */
+        if (x != mazeSize) {
+          auto step = std::min((step_t)99999, getStep(x, y));
+          os << (step == 0 ? C_YE : C_BL) << std::setw(5) << step << C_NO;
+        }
+      }
+      os << std::endl;
+    }
+    /* Horizontal Wall Line */
+    for (uint8_t x = 0; x < mazeSize; ++x) {
+      /* Pillar */
+      os << '+';
+      /* Horizontal Wall */
+      const auto w = maze.isWall(x, y, Direction::South);
+      const auto k = maze.isKnown(x, y, Direction::South);
+      const auto it = find(WallIndex(Position(x, y), Direction::South));
+      if (it != path.cend())
+        os << C_YE "\e[1m  " << it->d << "  " C_NO;
+      else
+        os << (k ? (w ? "-----" : "     ") : (C_RE "  .  " C_NO));
+    }
+    os << '+' << std::endl;
+  }
+}
+
+}  // namespace MazeLib
+
+#endif  // MAZE_IOSTREAM_DISABLED
@@ -0,0 +1,104 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief ワークスティーリング方式のスレッドプール
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/ThreadPool.h"
+
+#include <algorithm>  //< for std::max
+#include <cstdint>    //< for int64_t
+
+namespace MazeLib {
+
+ThreadPool::ThreadPool(const int size) {
+  const int n =
+      size > 0 ? size : std::max(1, int(std::thread::hardware_concurrency()));
+  for (int i = 0; i < n; ++i) ranges.emplace_back(new Range);
+  for (int i = 1; i < n; ++i) threads.emplace_back(&ThreadPool::run, this, i);
+}
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  startCv.notify_all();
+  for (auto& t : threads) t.join();
+}
+void ThreadPool::parallelFor(const int n, const Task& task) {
+  std::lock_guard<std::mutex> callLock(callMutex);
+  /* 添字の範囲をワーカーごとに等分 */
+  const int size = ranges.size();
+  for (int i = 0; i < size; ++i) {
+    std::lock_guard<std::mutex> lock(ranges[i]->mutex);
+    ranges[i]->begin = int64_t(n) * i / size;
+    ranges[i]->end = int64_t(n) * (i + 1) / size;
+  }
+  /* ワーカースレッドを起動し、自身もワーカー 0 として実行 */
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->task = &task;
+    running = threads.size();
+    ++generation;
+  }
+  startCv.notify_all();
+  work(0);
+  /* 全ワーカーの完了を待つ */
+  std::unique_lock<std::mutex> lock(mutex);
+  doneCv.wait(lock, [&] { return running == 0; });
+  this->task = nullptr;
+}
+void ThreadPool::run(const int worker) {
+  uint32_t seen = 0;
+  while (1) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      startCv.wait(lock, [&] { return stop || generation != seen; });
+      if (stop) return;
+      seen = generation;
+    }
+    work(worker);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--running == 0) doneCv.notify_one();
+    }
+  }
+}
+void ThreadPool::work(const int worker) {
+  int index;
+  while (next(worker, index)) (*task)(worker, index);
+}
+bool ThreadPool::next(const int worker, int& index) {
+  /* 自分の範囲の先頭から取る */
+  auto& own = *ranges[worker];
+  {
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.begin < own.end) {
+      index = own.begin++;
+      return true;
+    }
+  }
+  /* 他のワーカーの範囲の後ろ半分を奪う */
+  const int size = ranges.size();
+  for (int i = 1; i < size; ++i) {
+    auto& victim = *ranges[(worker + i) % size];
+    int begin, end;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const int remaining = victim.end - victim.begin;
+      if (remaining <= 0) continue;
+      begin = victim.end - (remaining + 1) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+    std::lock_guard<std::mutex> lock(own.mutex);
+    index = begin;
+    own.begin = begin + 1;
+    own.end = end;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace MazeLib
@@ -0,0 +1,88 @@
+/**
+ * @file WallValueEvaluator.cpp
+ * @brief 未知壁を確認する価値を並列に評価するクラス
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include "../include/MazeLib/WallValueEvaluator.h"
+
+#include <algorithm>  //< for std::max, std::min
+
+namespace MazeLib {
+
+std::vector<WallValueEvaluator::Result> WallValueEvaluator::evaluate(
+    const Maze& maze, const WallIndexes& walls, const Position start,
+    const Positions& dest, const bool knownOnly, const bool simple) {
+  /* 現状のステップマップと最短経路 */
+  auto& base = stepMaps[0];
+  const auto baseDirs =
+      base.calcShortestDirections(maze, start, dest, knownOnly, simple);
+  const auto baseCost = base.getStep(start);
+  /* 現在の最短経路上の壁 */
+  std::vector<bool> onPath(WallIndex::SIZE);
+  {
+    auto p = start;
+    for (const auto d : baseDirs) {
+      onPath[WallIndex(p, d).getIndex()] = true;
+      p = p.next(d);
+    }
+  }
+  /*
+   * 現状で通過できない壁 (knownOnly=true の未知壁、または壁ありの未知壁) は
+   * 壁ありの仮定が現状と同じで、壁なしの仮定のみ更新が必要となる。
+   * 仮定によってコストが変わりうる壁のみ、ステップマップを更新する。
+   */
+  std::vector<Result> results(walls.size());
+  std::vector<bool> blocked(walls.size());
+  std::vector<int> floods;
+  for (size_t i = 0; i < walls.size(); ++i) {
+    const auto wi = walls[i];
+    results[i] = {wi, baseCost, baseCost, 0};
+    if (!wi.isInsideOfField() || maze.isKnown(wi)) continue;
+    blocked[i] = !maze.canGo(wi, knownOnly);
+    bool needed;
+    if (!blocked[i])
+      needed = onPath[wi.getIndex()];
+    else
+      needed = base.getStep(wi.getPosition()) != StepMap::STEP_MAX ||
+               base.getStep(wi.getPosition().next(wi.getDirection())) !=
+                   StepMap::STEP_MAX;
+    if (needed) floods.push_back(i);
+  }
+  /* ワーカーごとに迷路を複製し、仮定を設定しては元に戻す */
+  for (auto& m : mazes) m = maze;
+  pool.parallelFor(floods.size(), [&](const int worker, const int index) {
+    const auto i = floods[index];
+    auto& r = results[i];
+    auto& m = mazes[worker];
+    auto& stepMap = stepMaps[worker];
+    const auto wall = m.isWall(r.i);
+    m.setWall(r.i, !blocked[i]);  //< 現状と異なる側を仮定
+    m.setKnown(r.i, true);
+    stepMap.update(m, dest, knownOnly, simple);
+    (blocked[i] ? r.costIfNoWall : r.costIfWall) = stepMap.getStep(start);
+    m.setWall(r.i, wall);
+    m.setKnown(r.i, false);
+  });
+  /* スコアはコストの差 */
+  for (auto& r : results) {
+    const auto lo = std::min(r.costIfWall, r.costIfNoWall);
+    const auto hi = std::max(r.costIfWall, r.costIfNoWall);
+    r.score = hi == StepMap::STEP_MAX ? (lo == StepMap::STEP_MAX ? 0 : hi)
+                                      : hi - lo;
+  }
+  return results;
+}
+std::vector<WallValueEvaluator::Result> WallValueEvaluator::evaluate(
+    const Maze& maze, const bool knownOnly, const bool simple) {
+  WallIndexes walls;
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (wi.isInsideOfField() && !maze.isKnown(wi)) walls.push_back(wi);
+  }
+  return evaluate(maze, walls, maze.getStart(), maze.getGoals(), knownOnly,
+                  simple);
+}
+
+}  // namespace MazeLib
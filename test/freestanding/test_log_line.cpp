@@ -0,0 +1,77 @@
+/**
+ * @file test_log_line.cpp
+ * @brief Unit Test for MazeLib::LogLine (MAZE_IOSTREAM_DISABLED)
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "MazeLib/Maze.h"
+
+using namespace MazeLib;
+
+#ifndef MAZE_IOSTREAM_DISABLED
+#error "this test must be built with MAZE_IOSTREAM_DISABLED"
+#endif
+
+/* 最後に受け取ったログ */
+static int sinkCount = 0;
+static char sinkLevel = 0;
+static std::string sinkFile;
+static int sinkLine = 0;
+static std::string sinkMessage;
+static void sink(char level, const char* file, int line, const char* message) {
+  ++sinkCount;
+  sinkLevel = level;
+  sinkFile = file;
+  sinkLine = line;
+  sinkMessage = message;
+}
+
+TEST(LogLine, format) {
+  setLogSink(sink);
+  EXPECT_EQ(getLogSink(), sink);
+  sinkCount = 0;
+  const int line = __LINE__ + 1;
+  MAZE_LOGI << "step " << 12 << ' ' << -3L << ' ' << 1.5f << ' ' << 0.25
+            << ' ' << Position(1, 2) << MAZE_LOG_ENDL;
+  EXPECT_EQ(sinkCount, 1);
+  EXPECT_EQ(sinkLevel, 'I');
+  EXPECT_EQ(sinkFile, __FILE__);
+  EXPECT_EQ(sinkLine, line);
+  EXPECT_EQ(sinkMessage, "step 12 -3 1.5 0.25 (01, 02)");
+  MAZE_LOGE << MAZE_LOG_ENDL;
+  EXPECT_EQ(sinkCount, 2);
+  EXPECT_EQ(sinkLevel, 'E');
+  EXPECT_EQ(sinkMessage, "");
+  setLogSink(nullptr);
+}
+
+TEST(LogLine, truncate) {
+  setLogSink(sink);
+  const std::string s(100, 'a');
+  MAZE_LOGW << s.c_str() << s.c_str() << 123;
+  /* 末尾の '\0' を含めて 128 バイトに収まる */
+  EXPECT_EQ(sinkMessage, std::string(127, 'a'));
+  MAZE_LOGW << std::string(127, 'b').c_str() << 'c' << 4;
+  EXPECT_EQ(sinkMessage, std::string(127, 'b'));
+  MAZE_LOGW << std::string(126, 'd').c_str() << 567;
+  EXPECT_EQ(sinkMessage, std::string(126, 'd') + "5");
+  setLogSink(nullptr);
+}
+
+TEST(LogLine, nullSink) {
+  setLogSink(nullptr);
+  EXPECT_EQ(getLogSink(), nullptr);
+  sinkCount = 0;
+  MAZE_LOGD << "discarded" << MAZE_LOG_ENDL;
+  EXPECT_EQ(sinkCount, 0);
+  /* 出力しないストリームは出力先があっても何も渡さない */
+  setLogSink(sink);
+  MAZE_LOG_STREAM_NULL << "discarded" << 1 << MAZE_LOG_ENDL;
+  EXPECT_EQ(sinkCount, 0);
+  setLogSink(nullptr);
+}
@@ -0,0 +1,60 @@
+/**
+ * @file test_batch_planner.cpp
+ * @brief Unit Test for MazeLib::BatchPlanner
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <sstream>  //< for std::stringstream
+
+#include "MazeLib/BatchPlanner.h"
+
+using namespace MazeLib;
+
+TEST(BatchPlanner, calcShortestDirections) {
+  std::stringstream maze_stream;
+  maze_stream << R"(
++---+---+---+---+---+---+---+---+---+
+|               |                   |
++   +---+   +   +   +---+---+---+   +
+|       |   |   |   |               |
++---+   +   +   +   +   +---+---+---+
+|       |   |       |               |
++   +---+   +---+---+---+---+---+   +
+|       |   | G   G   G |           |
++---+   +   +   +   +   +   +---+---+
+|       |   | G   G   G |           |
++   +---+   +   +   +   +---+---+   +
+|       |   | G   G   G |       |   |
++---+   +   +   +---+---+   +   +   +
+|       |   |   |       |   |   |   |
++   +---+   +   +   +   +   +   +   +
+|       |   |   |   |   |   |   |   |
++   +   +   +   +   +   +   +   +   +
+|   | S |   |       |       |       |
++---+---+---+---+---+---+---+---+---+
+)";
+  Maze maze;
+  maze_stream >> maze;
+  /* 全区画対全区画の問い合わせ */
+  std::vector<BatchPlanner::Query> queries;
+  for (int8_t x = 0; x < 9; ++x)
+    for (int8_t y = 0; y < 9; ++y)
+      queries.push_back({Position(x, y), {Position(8 - x, 8 - y)}});
+  ThreadPool pool(3);
+  BatchPlanner planner(pool);
+  const auto results =
+      planner.calcShortestDirections(maze, queries, true, false);
+  const auto steps = planner.calcSteps(maze, queries, true, false);
+  ASSERT_EQ(results.size(), queries.size());
+  ASSERT_EQ(steps.size(), queries.size());
+  StepMap stepMap;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const auto& q = queries[i];
+    EXPECT_EQ(results[i], stepMap.calcShortestDirections(maze, q.start, q.dest,
+                                                         true, false));
+    EXPECT_EQ(steps[i], stepMap.getStep(q.start));
+  }
+}
@@ -0,0 +1,62 @@
+/**
+ * @file test_connectivity_tracker.cpp
+ * @brief Unit Test for MazeLib::ConnectivityTracker
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MazeLib/ConnectivityTracker.h"
+
+using namespace MazeLib;
+
+TEST(ConnectivityTracker, updateWall) {
+  for (unsigned int seed = 0; seed < 4; ++seed) {
+    std::mt19937 mt(seed);
+    Maze maze;
+    ConnectivityTracker tracker;
+    tracker.update(maze);
+    for (int n = 0; n < 400; ++n) {
+      const auto wi = WallIndex(mt() % WallIndex::SIZE);
+      if (!wi.isInsideOfField()) continue;
+      tracker.updateWall(maze, wi.getPosition(), wi.getDirection(), mt() % 2);
+      if (n % 20) continue;
+      /* 全体を作り直した場合と一致する */
+      ConnectivityTracker full;
+      full.update(maze);
+      ASSERT_EQ(tracker.getComponentCount(), full.getComponentCount());
+      for (int i = 0; i < Position::SIZE; ++i) {
+        const auto a = Position::getPositionFromIndex(i);
+        const auto b = Position::getPositionFromIndex(mt() % Position::SIZE);
+        EXPECT_EQ(tracker.isReachable(a, b), full.isReachable(a, b));
+      }
+    }
+  }
+}
+
+TEST(ConnectivityTracker, getUnreachableUnknownWalls) {
+  Maze maze({Position(15, 15)});
+  ConnectivityTracker tracker;
+  tracker.update(maze);
+  EXPECT_EQ(tracker.getComponentCount(), 1);
+  EXPECT_TRUE(tracker.getUnreachableUnknownWalls(maze.getStart()).empty());
+  /* (14,14) から (15,15) の 2x2 区画を閉じる */
+  for (const auto p : {Position(14, 14), Position(14, 15)})
+    tracker.updateWall(maze, p, Direction::West, true);
+  EXPECT_TRUE(tracker.isReachable(maze.getStart(), maze.getGoals()));
+  for (const auto p : {Position(14, 14), Position(15, 14)})
+    tracker.updateWall(maze, p, Direction::South, true);
+  EXPECT_FALSE(tracker.isReachable(maze.getStart(), maze.getGoals()));
+  EXPECT_EQ(tracker.getComponentCount(), 2);
+  /* 小さい側のみ番号を付け直す */
+  EXPECT_EQ(tracker.getRelabelCount(), 4);
+  /* 閉じた領域内部の未知壁 */
+  EXPECT_EQ(tracker.getUnreachableUnknownWalls(maze.getStart()).size(), 4);
+  /* 既知の壁と不一致なら未知壁 (通過可能) に戻り、再び連結する */
+  tracker.updateWall(maze, Position(14, 14), Direction::West, false);
+  EXPECT_TRUE(tracker.isReachable(maze.getStart(), maze.getGoals()));
+  EXPECT_EQ(tracker.getComponentCount(), 1);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_corridor_graph.cpp
+ * @brief Unit Test for MazeLib::CorridorGraph
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>  //< for std::find
+#include <random>
+
+#include "MazeLib/CorridorGraph.h"
+
+using namespace MazeLib;
+
+/**
+ * @brief 方向列が始点から目的地まで既知壁のみで移動できるか確認する
+ */
+static bool isValidPath(const Maze& maze, Position p, const Directions& dirs,
+                        const Positions& dest) {
+  for (const auto d : dirs) {
+    if (!maze.canGo(p, d)) return false;
+    p = p.next(d);
+  }
+  return std::find(dest.cbegin(), dest.cend(), p) != dest.cend();
+}
+
+TEST(CorridorGraph, calcStep) {
+  StepMap stepMap;
+  CorridorGraph graph;
+  for (unsigned int seed = 0; seed < 20; ++seed) {
+    /* 通路と袋小路の多い既知の迷路 */
+    std::mt19937 mt(seed);
+    Maze maze({Position(7, 7), Position(7, 8), Position(8, 7), Position(8, 8)});
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      const auto wi = WallIndex(i);
+      if (wi.isInsideOfField())
+        maze.updateWall(wi.getPosition(), wi.getDirection(), mt() % 5 < 2);
+    }
+    EXPECT_TRUE(graph.update(maze, true));
+    EXPECT_FALSE(graph.update(maze, true));
+    EXPECT_LT(graph.getNodeCount(), graph.getKeptCellCount());
+    /* ゴール区画と、通路や袋小路の中の任意の区画を目的地とする */
+    for (const auto& dest :
+         {maze.getGoals(), Positions{Position(mt() % MAZE_SIZE, mt() % 4),
+                                     Position(mt() % 4, mt() % MAZE_SIZE)}}) {
+      stepMap.update(maze, dest, true, true);
+      for (int8_t x = 0; x < MAZE_SIZE; ++x) {
+        for (int8_t y = 0; y < MAZE_SIZE; ++y) {
+          const auto p = Position(x, y);
+          const auto step = graph.calcStep(p, dest);
+          ASSERT_EQ(step, stepMap.getStep(p)) << p << " seed: " << seed;
+          if (step == StepMap::STEP_MAX) continue;
+          const auto dirs = graph.calcShortestDirections(p, dest);
+          EXPECT_EQ(dirs.size(), step);
+          EXPECT_TRUE(isValidPath(maze, p, dirs, dest));
+        }
+      }
+    }
+  }
+}
+
+TEST(CorridorGraph, update) {
+  Maze maze({Position(3, 3)});
+  CorridorGraph graph;
+  EXPECT_EQ(graph.calcStep(maze.getStart(), maze.getGoals()),
+            CorridorGraph::STEP_MAX);
+  EXPECT_TRUE(graph.update(maze, false));
+  EXPECT_EQ(graph.calcStep(maze.getStart(), maze.getGoals()), 6);
+  /* 壁の更新は、未知壁を通過可能とするグラフでも再構築が必要 */
+  maze.updateWall(Position(0, 1), Direction::North, true);
+  EXPECT_TRUE(graph.update(maze, false));
+  EXPECT_FALSE(graph.update(maze, false));
+  EXPECT_TRUE(graph.update(maze, true));
+  EXPECT_EQ(graph.calcStep(maze.getStart(), maze.getGoals()),
+            CorridorGraph::STEP_MAX);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_dual_step_map.cpp
+ * @brief Unit Test for MazeLib::DualStepMap
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MazeLib/DualStepMap.h"
+#include "MazeLib/MazeGenerator.h"
+
+using namespace MazeLib;
+
+/**
+ * @brief 生成した迷路の一部の壁を未知にする
+ * @details 探索中と同じく多くは壁なしの未知壁とし、一部は壁ありのまま
+ * 未知壁とする (どちらのレーンでも通過不可)
+ */
+static Maze searchingMaze(const int seed, const MazeGenerator::Topology t,
+                          const int unknownRate) {
+  auto maze = MazeGenerator(seed).generate(t);
+  std::mt19937 mt(seed);
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (!wi.isInsideOfField() || int(mt() % 100) >= unknownRate) continue;
+    maze.setKnown(wi, false);
+    if (mt() % 4) maze.setWall(wi, false);
+  }
+  return maze;
+}
+
+TEST(DualStepMap, update) {
+  DualStepMap dual;
+  StepMap known, optimistic;
+  for (int t = 0; t < MazeGenerator::TopologyMax; ++t) {
+    for (const int unknownRate : {0, 20, 60}) {
+      const auto maze =
+          searchingMaze(t, MazeGenerator::Topology(t), unknownRate);
+      for (const bool simple : {true, false}) {
+        dual.update(maze, maze.getGoals(), simple);
+        known.update(maze, maze.getGoals(), true, simple);
+        optimistic.update(maze, maze.getGoals(), false, simple);
+        /* それぞれのレーンが StepMap と一致する */
+        for (int i = 0; i < Position::SIZE; ++i) {
+          const auto p = Position::getPositionFromIndex(i);
+          ASSERT_EQ(dual.getStep(p, true), known.getStep(p)) << p;
+          ASSERT_EQ(dual.getStep(p, false), optimistic.getStep(p)) << p;
+        }
+        /* 1回の走査で2回分の更新を行う */
+        EXPECT_LT(dual.getCounters().relaxations,
+                  known.getCounters().relaxations +
+                      optimistic.getCounters().relaxations);
+      }
+    }
+  }
+}
+
+TEST(DualStepMap, isKnownShortest) {
+  const auto maze = searchingMaze(5, MazeGenerator::Braided, 30);
+  DualStepMap dual;
+  dual.update(maze, maze.getGoals(), false);
+  for (int i = 0; i < Position::SIZE; ++i) {
+    const auto p = Position::getPositionFromIndex(i);
+    const auto s = dual.getSteps(p);
+    /* 未知壁を通過可能とした方が短い */
+    EXPECT_LE(s.optimistic, s.known);
+    EXPECT_EQ(dual.isKnownShortest(p),
+              s.known != DualStepMap::STEP_MAX && s.known == s.optimistic);
+  }
+  EXPECT_TRUE(dual.isKnownShortest(maze.getGoals()[0]));
+  EXPECT_FALSE(dual.isKnownShortest(Position(-1, 0)));
+}
@@ -0,0 +1,84 @@
+/**
+ * @file test_hierarchical_planner.cpp
+ * @brief Unit Test for MazeLib::HierarchicalPlanner
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MazeLib/HierarchicalPlanner.h"
+
+using namespace MazeLib;
+
+TEST(HierarchicalPlanner, calcShortestDirections) {
+  StepMap stepMap;
+  for (const int clusterSize : {3, 4, 8}) {
+    HierarchicalPlanner planner(clusterSize);
+    for (unsigned int seed = 0; seed < 8; ++seed) {
+      std::mt19937 mt(seed);
+      Maze maze(
+          {Position(7, 7), Position(7, 8), Position(8, 7), Position(8, 8)});
+      for (int i = 0; i < WallIndex::SIZE; ++i) {
+        const auto wi = WallIndex(i);
+        if (wi.isInsideOfField() && mt() % 2)
+          maze.updateWall(wi.getPosition(), wi.getDirection(), mt() % 3 == 0);
+      }
+      for (const auto knownOnly : {false, true}) {
+        planner.update(maze, knownOnly);
+        stepMap.update(maze, maze.getGoals(), knownOnly, true);
+        for (int8_t x = 0; x < MAZE_SIZE; x += 3) {
+          for (int8_t y = 0; y < MAZE_SIZE; y += 2) {
+            const auto p = Position(x, y);
+            const auto step = stepMap.getStep(p);
+            ASSERT_EQ(planner.calcStep(p, maze.getGoals()), step) << p;
+            const auto dirs =
+                planner.calcShortestDirections(p, maze.getGoals());
+            if (step == StepMap::STEP_MAX) {
+              EXPECT_TRUE(dirs.empty());
+              continue;
+            }
+            /* 経路の検証 */
+            ASSERT_EQ(dirs.size(), step);
+            auto q = p;
+            for (const auto d : dirs) {
+              EXPECT_FALSE(maze.isWall(q, d));
+              if (knownOnly) EXPECT_TRUE(maze.isKnown(q, d));
+              q = q.next(d);
+            }
+            EXPECT_EQ(stepMap.getStep(q), 0);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(HierarchicalPlanner, invalidate) {
+  Maze maze({Position(15, 15)});
+  HierarchicalPlanner planner(4);
+  planner.update(maze, false);
+  EXPECT_EQ(planner.calcStep(maze.getStart(), maze.getGoals()), 30);
+  const auto rebuilt = planner.getRebuildCount();
+  EXPECT_GT(rebuilt, 0);
+  EXPECT_GT(planner.calcShortestDirections(maze.getStart(), maze.getGoals())
+                .size(),
+            0);
+  EXPECT_LE(planner.getRefinedClusterCount(), 7);
+  /* 変化がなければ再計算しない */
+  planner.update(maze, false);
+  planner.calcStep(maze.getStart(), maze.getGoals());
+  EXPECT_EQ(planner.getRebuildCount(), rebuilt);
+  /* クラスタ内部の壁の変化は、そのクラスタのみ再計算する */
+  maze.updateWall(Position(1, 1), Direction::East, true);
+  planner.update(maze, false);
+  planner.calcStep(maze.getStart(), maze.getGoals());
+  EXPECT_EQ(planner.getRebuildCount(), rebuilt + 1);
+  /* 境界の壁の変化は、両側のクラスタを再計算する */
+  maze.updateWall(Position(3, 1), Direction::East, true);
+  planner.update(maze, false);
+  planner.calcStep(maze.getStart(), maze.getGoals());
+  EXPECT_EQ(planner.getRebuildCount(), rebuilt + 3);
+}
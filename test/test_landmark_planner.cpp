@@ -0,0 +1,93 @@
+/**
+ * @file test_landmark_planner.cpp
+ * @brief Unit Test for MazeLib::LandmarkPlanner
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MazeLib/LandmarkPlanner.h"
+
+using namespace MazeLib;
+
+TEST(LandmarkPlanner, calcShortestDirections) {
+  StepMap stepMap;
+  LandmarkPlanner planner;
+  for (unsigned int seed = 0; seed < 8; ++seed) {
+    std::mt19937 mt(seed);
+    Maze maze({Position(7, 7), Position(7, 8), Position(8, 7), Position(8, 8)});
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      const auto wi = WallIndex(i);
+      if (wi.isInsideOfField() && mt() % 2)
+        maze.updateWall(wi.getPosition(), wi.getDirection(), mt() % 3 == 0);
+    }
+    for (const auto knownOnly : {false, true}) {
+      planner.invalidate();
+      planner.update(maze, knownOnly);
+      for (int8_t x = 0; x < MAZE_SIZE; x += 3) {
+        for (int8_t y = 0; y < MAZE_SIZE; y += 2) {
+          const auto dest = Position(x, y);
+          stepMap.update(maze, {dest}, knownOnly, true);
+          for (const auto p : {maze.getStart(), Position(15, 15),
+                               Position(y, x), Position(5, 9)}) {
+            const auto step = stepMap.getStep(p);
+            ASSERT_EQ(planner.calcStep(p, {dest}), step) << p << dest;
+            if (step == StepMap::STEP_MAX) continue;
+            EXPECT_LE(planner.getLowerBound(p, dest), step);
+            /* 経路の検証 */
+            const auto dirs = planner.calcShortestDirections(p, {dest});
+            ASSERT_EQ(dirs.size(), step);
+            auto q = p;
+            for (const auto d : dirs) {
+              EXPECT_FALSE(maze.isWall(q, d));
+              if (knownOnly) EXPECT_TRUE(maze.isKnown(q, d));
+              q = q.next(d);
+            }
+            EXPECT_EQ(q, dest);
+          }
+        }
+      }
+      /* 目的地の集合 */
+      stepMap.update(maze, maze.getGoals(), knownOnly, true);
+      EXPECT_EQ(planner.calcStep(maze.getStart(), maze.getGoals()),
+                stepMap.getStep(maze.getStart()));
+    }
+  }
+}
+
+TEST(LandmarkPlanner, update) {
+  Maze maze({Position(15, 15)});
+  LandmarkPlanner planner;
+  EXPECT_TRUE(planner.update(maze, false));
+  /* 四隅 (スタートとゴールを含む) */
+  EXPECT_EQ(planner.getLandmarks().size(), 4);
+  EXPECT_EQ(planner.calcStep(maze.getStart(), maze.getGoals()), 30);
+  /* 下界が正確なので、最短経路上の区画のみ展開する */
+  EXPECT_EQ(planner.getExpandedCount(), 31);
+  /* 変化がなければ再計算しない */
+  EXPECT_FALSE(planner.update(maze, false));
+  /* 壁が増えるだけなら再計算せず、下界は許容的なまま */
+  maze.updateWall(Position(0, 0), Direction::East, true);
+  maze.updateWall(Position(0, 0), Direction::North, false);
+  EXPECT_FALSE(planner.update(maze, false));
+  EXPECT_EQ(planner.calcStep(Position(0, 0), {Position(1, 0)}), 3);
+  /* 壁がなくなれば再計算する */
+  maze.updateWall(Position(0, 0), Direction::East, false);
+  EXPECT_TRUE(planner.update(maze, false));
+  EXPECT_EQ(planner.calcStep(Position(0, 0), {Position(1, 0)}), 1);
+  /* 明示的な無効化 */
+  planner.invalidate();
+  EXPECT_TRUE(planner.update(maze, false));
+  EXPECT_EQ(planner.getRefreshCount(), 3);
+  /* 連結していない区画 */
+  maze.updateWall(Position(15, 15), Direction::West, true);
+  maze.updateWall(Position(15, 15), Direction::South, true);
+  EXPECT_FALSE(planner.update(maze, false));
+  EXPECT_EQ(planner.calcStep(maze.getStart(), maze.getGoals()),
+            LandmarkPlanner::STEP_MAX);
+  EXPECT_TRUE(
+      planner.calcShortestDirections(maze.getStart(), maze.getGoals()).empty());
+}
@@ -0,0 +1,47 @@
+/**
+ * @file test_look_ahead_planner.cpp
+ * @brief Unit Test for MazeLib::LookAheadPlanner
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include "MazeLib/LookAheadPlanner.h"
+
+using namespace MazeLib;
+
+TEST(LookAheadPlanner, get) {
+  Maze maze({Position(3, 3)});
+  maze.updateWall(Position(0, 1), Direction::West, true);
+  const auto next = Pose(Position(0, 1), Direction::North);
+  LookAheadPlanner planner;
+  for (int c = 0; c < LookAheadPlanner::CASE_SIZE; ++c) {
+    const bool front = c & 1, left = c & 2, right = c & 4;
+    planner.start(maze, next, maze.getGoals(), false, true);
+    /* 同期的に計算した経路と一致する */
+    Maze expected = maze;
+    expected.updateWall(next.p, next.d + Direction::Front, front);
+    expected.updateWall(next.p, next.d + Direction::Left, left);
+    expected.updateWall(next.p, next.d + Direction::Right, right);
+    StepMap stepMap;
+    EXPECT_EQ(planner.get(front, left, right),
+              stepMap.calcShortestDirections(expected, next.p,
+                                             expected.getGoals(), false, true));
+  }
+}
+
+TEST(LookAheadPlanner, mismatch) {
+  Maze maze({Position(3, 3)});
+  maze.updateWall(Position(0, 1), Direction::West, true);
+  const auto next = Pose(Position(0, 1), Direction::North);
+  LookAheadPlanner planner;
+  planner.start(maze, next, maze.getGoals(), false, true);
+  /* 既知壁 (左) と食い違うと、その場で計算し直す */
+  Maze expected = maze;
+  expected.updateWall(next.p, next.d + Direction::Left, false);
+  StepMap stepMap;
+  EXPECT_EQ(planner.get(false, false, false),
+            stepMap.calcShortestDirections(expected, next.p,
+                                           expected.getGoals(), false, true));
+}
@@ -10,6 +10,7 @@
 #include <algorithm>
 
 #include "MazeLib/Maze.h"
+#include "MazeLib/MazeGenerator.h"
 
 using namespace MazeLib;
 
@@ -96,3 +97,114 @@ TEST(Maze, parse_from_string_array) {
   sample.print(std::cout, mazeSize);
   ::testing::internal::GetCapturedStdout();
 }
+
+TEST(Maze, diff) {
+  Maze a, b;
+  const auto p = Position(2, 3);
+  a.updateWall(p, Direction::East, true);
+  b.updateWall(p, Direction::East, false);
+  b.updateWall(p, Direction::North, true);
+  const auto d = a.diff(b);
+  EXPECT_EQ(d.mismatched.count(), 1U);
+  EXPECT_TRUE(d.mismatched[WallIndex(p, Direction::East).getIndex()]);
+  EXPECT_EQ(d.unknown.count(), 1U);
+  const auto unknown = Maze::Diff::toWallIndexes(d.unknown);
+  ASSERT_EQ(unknown.size(), 1U);
+  EXPECT_EQ(unknown[0], WallIndex(p, Direction::North));
+  EXPECT_TRUE(a.diff(a).mismatched.none());
+}
+
+TEST(Maze, merge) {
+  const auto p = Position(2, 3);
+  const auto q = Position(5, 6);
+  const auto make = [&](const bool b) {
+    Maze m;
+    m.updateWall(p, Direction::East, b);
+    return m;
+  };
+  for (const bool b : {true, false}) {
+    Maze other = make(!b);
+    other.updateWall(q, Direction::North, true);
+    /* 不一致の壁の解決後の状態 (-1: 未知, 0: 壁なし, 1: 壁あり) */
+    const std::pair<Maze::MergePolicy, int> cases[] = {
+        {Maze::KeepThis, b},
+        {Maze::TakeOther, !b},
+        {Maze::MarkUnknown, -1},
+        {Maze::PreferWall, 1},
+    };
+    for (const auto& c : cases) {
+      Maze maze = make(b);
+      const auto records = maze.getWallRecords().size();
+      EXPECT_EQ(maze.merge(other, c.first), 1);
+      /* 未知壁は取り込まれる */
+      EXPECT_TRUE(maze.isKnown(q, Direction::North));
+      EXPECT_TRUE(maze.isWall(q, Direction::North));
+      EXPECT_EQ(maze.getMaxX(), q.x);
+      /* 不一致の解決 */
+      EXPECT_EQ(maze.isKnown(p, Direction::East), c.second >= 0);
+      EXPECT_EQ(maze.isWall(p, Direction::East), c.second == 1);
+      EXPECT_EQ(maze.diff(other).unknown.count(), c.second >= 0 ? 0U : 1U);
+      /* 変化しない壁は記録しない */
+      const bool changed = c.second != b;
+      EXPECT_EQ(maze.getWallRecords().size() - records,
+                1U + (changed ? (c.second >= 0 ? 2U : 1U) : 0U));
+      /* 壁ログを再生すると取り込み後の迷路と一致する */
+      Maze replayed;
+      for (const auto& wr : maze.getWallRecords())
+        replayed.updateWall(wr.getPosition(), wr.getDirection(), wr.b);
+      EXPECT_EQ(replayed.getWallBits(), maze.getWallBits());
+      EXPECT_EQ(replayed.getKnownBits(), maze.getKnownBits());
+    }
+  }
+}
+
+TEST(Maze, transform) {
+  const int n = MAZE_SIZE;
+  EXPECT_EQ(Maze::transformPosition(Position(0, 0), 0, n), Position(0, 0));
+  EXPECT_EQ(Maze::transformPosition(Position(0, 0), 1, n),
+            Position(n - 1, 0));
+  EXPECT_EQ(Maze::transformPosition(Position(0, 0), 2, n),
+            Position(n - 1, n - 1));
+  EXPECT_EQ(Maze::transformPosition(Position(1, 2), 4, n), Position(2, 1));
+  EXPECT_EQ(Maze::transformDirection(Direction::East, 1), Direction::North);
+  EXPECT_EQ(Maze::transformDirection(Direction::East, 4), Direction::North);
+  EXPECT_EQ(Maze::transformDirection(Direction::South, 4), Direction::West);
+  EXPECT_EQ(Maze::transformDirection(Direction::South, 5), Direction::South);
+  /* 壁の両側の区画と方向の変換が整合する */
+  for (int s = 0; s < Maze::SYMMETRY_SIZE; ++s) {
+    const auto p = Position(3, 5);
+    for (const auto d : Direction::Along4())
+      EXPECT_EQ(Maze::transformPosition(p, s, n)
+                    .next(Maze::transformDirection(d, s)),
+                Maze::transformPosition(p.next(d), s, n));
+  }
+  /* 迷路全体の変換は壁ごとの変換と一致する */
+  for (const int size : {MAZE_SIZE, 9}) {
+    auto maze = MazeGenerator(size).generate(MazeGenerator::Braided, size);
+    for (int8_t x = 0; x < size; ++x)
+      for (int8_t y = 0; y < size; y += 3)
+        maze.setKnown(Position(x, y), Direction::North, false);
+    for (int s = 0; s < Maze::SYMMETRY_SIZE; ++s) {
+      const auto t = maze.transform(s, size);
+      EXPECT_EQ(t.getStart(),
+                Maze::transformPosition(maze.getStart(), s, size));
+      EXPECT_EQ(t.getGoals()[0],
+                Maze::transformPosition(maze.getGoals()[0], s, size));
+      for (int8_t x = 0; x < size; ++x) {
+        for (int8_t y = 0; y < size; ++y) {
+          const auto p = Position(x, y);
+          const auto q = Maze::transformPosition(p, s, size);
+          for (const auto d : Direction::Along4()) {
+            const auto e = Maze::transformDirection(d, s);
+            EXPECT_EQ(t.isWall(q, e), maze.isWall(p, d)) << p << d << s;
+            EXPECT_EQ(t.isKnown(q, e), maze.isKnown(p, d)) << p << d << s;
+          }
+        }
+      }
+      /* 逆変換で元に戻る (範囲外の壁は削除される) */
+      const int inverse = s >= 4 ? s : (4 - s) % 4;
+      EXPECT_EQ(t.transform(inverse, size).getWallBits(),
+                maze.transform(0, size).getWallBits());
+    }
+  }
+}
@@ -0,0 +1,68 @@
+/**
+ * @file test_maze_generator.cpp
+ * @brief Unit Test for MazeLib::MazeGenerator
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>  //< for std::remove
+
+#include "MazeLib/MazeGenerator.h"
+#include "MazeLib/StepMap.h"
+
+using namespace MazeLib;
+
+TEST(MazeGenerator, generate) {
+  StepMap stepMap;
+  for (int t = 0; t < MazeGenerator::TopologyMax; ++t) {
+    const auto topology = MazeGenerator::Topology(t);
+    for (const int size : {2, 5, 8, MAZE_SIZE}) {
+      for (const uint64_t seed : {0, 1, 2}) {
+        const auto maze = MazeGenerator(seed).generate(topology, size);
+        /* 同じシード値なら同じ迷路 */
+        const auto again = MazeGenerator(seed).generate(topology, size);
+        EXPECT_EQ(maze.getWallBits(), again.getWallBits());
+        EXPECT_EQ(maze.getKnownBits().count(), WallIndex::SIZE - 2 * MAZE_SIZE);
+        /* スタート区画 */
+        EXPECT_TRUE(maze.isWall(maze.getStart(), Direction::East));
+        EXPECT_FALSE(maze.isWall(maze.getStart(), Direction::North));
+        /* 迷路内のすべての区画へ到達可能で、迷路外へは到達不能 */
+        stepMap.update(maze, {maze.getStart()}, true, true);
+        int open = 0;
+        for (int8_t x = 0; x < MAZE_SIZE; ++x) {
+          for (int8_t y = 0; y < MAZE_SIZE; ++y) {
+            const bool inside = x < size && y < size;
+            EXPECT_EQ(stepMap.getStep(x, y) != StepMap::STEP_MAX, inside)
+                << MazeGenerator::getName(topology) << size << Position(x, y);
+            for (const auto d : {Direction::East, Direction::North})
+              open += !maze.isWall(x, y, d);
+          }
+        }
+        for (const auto p : maze.getGoals())
+          EXPECT_NE(stepMap.getStep(p), StepMap::STEP_MAX);
+        /* 閉路のない迷路の通路の数は、区画数 - 1 */
+        if (topology == MazeGenerator::Perfect)
+          EXPECT_EQ(open, size * size - 1);
+        if (topology == MazeGenerator::Braided && size > 2)
+          EXPECT_GT(open, size * size - 1);
+      }
+    }
+  }
+}
+
+TEST(MazeGenerator, save) {
+  const auto maze = MazeGenerator(3).generate(MazeGenerator::Competition, 8);
+  const std::string filepath = "generated.maze";
+  ASSERT_TRUE(MazeGenerator::save(maze, filepath, 8));
+  Maze parsed;
+  ASSERT_TRUE(parsed.parse(filepath));
+  EXPECT_EQ(parsed.getStart(), maze.getStart());
+  EXPECT_EQ(parsed.getGoals().size(), 4);
+  for (int8_t x = 0; x < 8; ++x)
+    for (int8_t y = 0; y < 8; ++y)
+      for (const auto d : Direction::Along4())
+        EXPECT_EQ(parsed.isWall(x, y, d), maze.isWall(x, y, d));
+  std::remove(filepath.c_str());
+}
@@ -0,0 +1,63 @@
+/**
+ * @file test_maze_index.cpp
+ * @brief Unit Test for MazeLib::MazeIndex
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>  //< for std::find_if
+
+#include "MazeLib/MazeGenerator.h"
+#include "MazeLib/MazeIndex.h"
+
+using namespace MazeLib;
+
+TEST(MazeIndex, find) {
+  MazeIndex index;
+  for (int t = 0; t < MazeGenerator::TopologyMax; ++t) {
+    const auto topology = MazeGenerator::Topology(t);
+    for (const uint64_t seed : {0, 1})
+      index.add(MazeGenerator(seed).generate(topology, MAZE_SIZE), MAZE_SIZE,
+                MazeGenerator::getName(topology));
+  }
+  EXPECT_EQ(index.size(), MazeGenerator::TopologyMax * 2);
+  /* 登録した迷路を対称変換して、一部の壁のみ既知にした迷路 */
+  const MazeIndex::Match answer = {2, 5};
+  const auto& wall = index.getWallBits(answer);
+  Maze maze;
+  maze.reset(false);
+  for (int8_t x = 0; x < 5; ++x) {
+    for (int8_t y = 0; y < 4; ++y) {
+      for (const auto d : Direction::Along4()) {
+        const auto i = WallIndex(Position(x, y), d);
+        maze.updateWall(Position(x, y), d,
+                        !i.isInsideOfField() || wall[i.getIndex()]);
+      }
+    }
+  }
+  const auto matches = index.find(maze);
+  EXPECT_NE(std::find_if(matches.cbegin(), matches.cend(),
+                         [&](const MazeIndex::Match& m) {
+                           return m.id == answer.id &&
+                                  m.symmetry == answer.symmetry;
+                         }),
+            matches.cend());
+  /* 検索結果はすべての既知壁と一致する */
+  for (const auto& m : matches) {
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      const auto wi = WallIndex(i);
+      if (wi.isInsideOfField() && maze.isKnown(wi))
+        EXPECT_EQ(index.getWallBits(m)[i], maze.isWall(wi));
+    }
+  }
+  /* 検索結果の壁の割合 */
+  const auto wi = WallIndex(Position(9, 9), Direction::East);
+  const auto ratio = index.calcWallRatio(matches, wi);
+  EXPECT_GE(ratio, 0);
+  EXPECT_LE(ratio, 1);
+  /* 既知壁がなければすべて一致する */
+  maze.reset(false);
+  EXPECT_EQ(index.find(maze).size(), index.size() * MazeIndex::SYMMETRY_SIZE);
+}
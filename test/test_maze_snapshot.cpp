@@ -0,0 +1,67 @@
+/**
+ * @file test_maze_snapshot.cpp
+ * @brief Unit Test for MazeLib::MazeSnapshots
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "MazeLib/MazeSnapshot.h"
+
+using namespace MazeLib;
+
+TEST(MazeSnapshots, publish_read) {
+  Maze maze;
+  MazeSnapshots snapshots(maze);
+  EXPECT_EQ(snapshots.getVersion(), 0);
+  maze.updateWall(Position(1, 1), Direction::East, true);
+  EXPECT_EQ(snapshots.publish(maze), 1);
+  const auto reader = snapshots.read(0);
+  EXPECT_EQ(reader.getVersion(), 1);
+  EXPECT_TRUE(reader->isWall(Position(1, 1), Direction::East));
+}
+
+TEST(MazeSnapshots, reclaim) {
+  Maze maze;
+  MazeSnapshots snapshots(maze);
+  {
+    /* 読み込み中の版は書き込みが進んでも回収されない */
+    const auto reader = snapshots.read(1);
+    for (int i = 0; i < 4; ++i) snapshots.publish(maze);
+    EXPECT_EQ(reader.getVersion(), 0);
+    EXPECT_GT(snapshots.reclaim(), 0);
+  }
+  EXPECT_EQ(snapshots.reclaim(), 0);
+  EXPECT_EQ(snapshots.read(1).getVersion(), 4);
+}
+
+TEST(MazeSnapshots, concurrent) {
+  Maze maze;
+  MazeSnapshots snapshots(maze);
+  const int num = 200;
+  std::thread writer([&] {
+    for (int i = 0; i < num; ++i) {
+      maze.updateWall(Position(i % MAZE_SIZE, i / MAZE_SIZE % MAZE_SIZE),
+                      Direction::North, true);
+      snapshots.publish(maze);
+    }
+  });
+  std::vector<std::thread> readers;
+  for (int id = 0; id < 2; ++id) {
+    readers.emplace_back([&, id] {
+      uint32_t version = 0;
+      while (version < num) {
+        const auto reader = snapshots.read(id);
+        /* 版と壁ログの長さは常に一致する */
+        EXPECT_EQ(reader->getWallRecords().size(), reader.getVersion());
+        EXPECT_GE(reader.getVersion(), version);
+        version = reader.getVersion();
+      }
+    });
+  }
+  writer.join();
+  for (auto& t : readers) t.join();
+}
@@ -43,3 +43,20 @@ TEST(Position, operator_left_shift_left_shift) {
   ss << Position(1, 2);
   EXPECT_EQ(ss.str(), "(  1,  2)");
 }
+
+TEST(Position, nextBatch) {
+  Positions src;
+  for (int8_t x = -1; x <= MAZE_SIZE; ++x)
+    for (int8_t y = -1; y <= MAZE_SIZE; ++y) src.push_back(Position(x, y));
+  for (int8_t d = 0; d < Direction::Max; ++d) {
+    Positions dst(src.size());
+    Position::nextBatch(src.data(), dst.data(), src.size(), Direction(d));
+    for (size_t i = 0; i < src.size(); ++i)
+      EXPECT_EQ(dst[i], src[i].next(Direction(d))) << src[i] << +d;
+  }
+  /* 通し番号 */
+  std::vector<uint16_t> indexes(src.size());
+  Position::getIndexBatch(src.data(), indexes.data(), src.size());
+  for (size_t i = 0; i < src.size(); ++i)
+    if (src[i].isInsideOfField()) EXPECT_EQ(indexes[i], src[i].getIndex());
+}
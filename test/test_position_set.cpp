@@ -0,0 +1,62 @@
+/**
+ * @file test_position_set.cpp
+ * @brief Unit Test for MazeLib::PositionSet
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>  //< for std::find
+
+#include "MazeLib/Maze.h"
+
+using namespace MazeLib;
+
+TEST(PositionSet, insert) {
+  PositionSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.insert(Position(3, 4)));
+  EXPECT_FALSE(set.insert(Position(3, 4)));
+  EXPECT_FALSE(set.insert(Position(-1, 0)));
+  EXPECT_TRUE(set.insert(Position(7, 1)));
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_TRUE(set.contains(Position(3, 4)));
+  EXPECT_FALSE(set.contains(Position(4, 3)));
+  EXPECT_FALSE(set.contains(Position(MAZE_SIZE, 0)));
+  EXPECT_EQ(set.getMinX(), 3);
+  EXPECT_EQ(set.getMinY(), 1);
+  EXPECT_EQ(set.getMaxX(), 7);
+  EXPECT_EQ(set.getMaxY(), 4);
+  /* 削除すると最小最大の座標も更新される */
+  EXPECT_TRUE(set.erase(Position(7, 1)));
+  EXPECT_FALSE(set.erase(Position(7, 1)));
+  EXPECT_EQ(set.getMinY(), 4);
+  EXPECT_EQ(set.getMaxX(), 3);
+  set.clear();
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(set.getMinX(), MAZE_SIZE - 1);
+  EXPECT_EQ(set.getMaxX(), 0);
+}
+
+TEST(PositionSet, iterate) {
+  const Positions positions = {
+      Position(MAZE_SIZE - 1, MAZE_SIZE - 1),
+      Position(0, 0),
+      Position(5, 2),
+      Position(0, 0),
+      Position(2, 5),
+  };
+  const PositionSet set(positions);
+  EXPECT_EQ(set.size(), 4);
+  /* Position::getIndex() の昇順に走査する */
+  const auto sorted = set.toPositions();
+  ASSERT_EQ(sorted.size(), 4U);
+  for (size_t i = 1; i < sorted.size(); ++i)
+    EXPECT_LT(sorted[i - 1].getIndex(), sorted[i].getIndex());
+  for (const auto p : set)
+    EXPECT_NE(std::find(positions.cbegin(), positions.cend(), p),
+              positions.cend());
+  EXPECT_EQ(PositionSet(sorted), set);
+  EXPECT_EQ(PositionSet().begin(), PositionSet().end());
+}
@@ -0,0 +1,68 @@
+/**
+ * @file test_region_pruner.cpp
+ * @brief Unit Test for MazeLib::RegionPruner
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "MazeLib/RegionPruner.h"
+
+using namespace MazeLib;
+
+TEST(RegionPruner, update) {
+  StepMap stepMap;
+  RegionPruner pruner;
+  for (unsigned int seed = 0; seed < 16; ++seed) {
+    std::mt19937 mt(seed);
+    /* 真の迷路と、その一部の壁のみ既知の迷路 */
+    Maze target({Position(7, 7), Position(7, 8), Position(8, 7)});
+    Maze maze(target.getGoals());
+    for (int i = 0; i < WallIndex::SIZE; ++i) {
+      const auto wi = WallIndex(i);
+      if (!wi.isInsideOfField()) continue;
+      const bool b = mt() % 3 == 0;
+      target.updateWall(wi.getPosition(), wi.getDirection(), b);
+      if (mt() % 2) maze.updateWall(wi.getPosition(), wi.getDirection(), b);
+    }
+    pruner.update(maze, maze.getStart(), maze.getGoals());
+    const auto& stats = pruner.getStats();
+    EXPECT_EQ(stats.getTotal(), pruner.getIrrelevantBits().count());
+    /* 始点が無関係なのは、目的地へ到達できない場合のみ */
+    EXPECT_EQ(pruner.isIrrelevant(maze.getStart()),
+              stats.unreachable == Position::SIZE);
+    /* 真の迷路の最短経路は、枝刈りした区画を通らない */
+    stepMap.update(target, target.getGoals(), true, true);
+    const auto step = stepMap.getStep(target.getStart());
+    pruner.seal(target);
+    stepMap.update(target, target.getGoals(), true, true);
+    EXPECT_EQ(stepMap.getStep(target.getStart()), step);
+    /* 既知経路の長さ */
+    stepMap.update(maze, maze.getGoals(), true, true);
+    EXPECT_EQ(pruner.getKnownCost(), stepMap.getStep(maze.getStart()));
+  }
+}
+
+TEST(RegionPruner, getStats) {
+  Maze maze({Position(2, 0)});
+  maze.reset(false);
+  /* 最下段は (1,0) のみ北側の部屋に通じ、(3,0) は袋小路 */
+  for (int8_t x = 0; x < MAZE_SIZE; ++x)
+    maze.updateWall(Position(x, 0), Direction::North, x != 1);
+  maze.updateWall(Position(3, 0), Direction::East, true);
+  RegionPruner pruner;
+  pruner.update(maze, maze.getStart(), maze.getGoals());
+  const auto& stats = pruner.getStats();
+  EXPECT_EQ(stats.unreachable, MAZE_SIZE - 4);
+  EXPECT_EQ(stats.deadEnd, 1);
+  EXPECT_EQ(stats.articulation, Position::SIZE - MAZE_SIZE);
+  EXPECT_EQ(stats.detour, 0);
+  EXPECT_EQ(pruner.getKnownCost(), RegionPruner::STEP_MAX);
+  for (int8_t x = 0; x < 3; ++x)
+    EXPECT_FALSE(pruner.isIrrelevant(Position(x, 0)));
+  EXPECT_TRUE(pruner.isIrrelevant(WallIndex(Position(1, 0), Direction::North)));
+  EXPECT_FALSE(pruner.isIrrelevant(WallIndex(Position(1, 0), Direction::East)));
+}
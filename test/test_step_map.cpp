@@ -0,0 +1,197 @@
+/**
+ * @file test_step_map.cpp
+ * @brief Unit Test for MazeLib::StepMap
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>  //< for std::find
+#include <random>
+
+#include "MazeLib/StepMap.h"
+#include "MazeLib/ThreadPool.h"
+
+using namespace MazeLib;
+
+/**
+ * @brief 壁をランダムに配置した迷路を生成する
+ */
+static Maze randomMaze(const unsigned int seed, const float wallRate,
+                       const float knownRate) {
+  std::mt19937 mt(seed);
+  std::uniform_real_distribution<float> uni(0, 1);
+  Maze maze({Position(MAZE_SIZE / 2, MAZE_SIZE / 2)});
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (!wi.isInsideOfField()) continue;
+    const bool b = uni(mt) < wallRate;
+    if (uni(mt) < knownRate)
+      maze.updateWall(wi.getPosition(), wi.getDirection(), b);
+    else
+      maze.setWall(wi, b);  //< 未知壁 (壁ありなら knownOnly=false でも通過不可)
+  }
+  return maze;
+}
+
+TEST(StepMap, calcShortestDirections) {
+  Maze maze({Position(3, 3)});
+  StepMap stepMap;
+  const auto dirs = stepMap.calcShortestDirections(maze, false, true);
+  EXPECT_EQ(dirs.size(), 6);
+  EXPECT_EQ(stepMap.getStep(maze.getStart()), 6);
+  /* 既知壁のみでは経路がない */
+  EXPECT_TRUE(stepMap.calcShortestDirections(maze, true, true).empty());
+}
+
+TEST(StepMap, updateParallel) {
+  ThreadPool pool(3);
+  StepMap stepMap, stepMapParallel;
+  for (unsigned int seed = 0; seed < 40; ++seed) {
+    const auto maze = randomMaze(seed, 0.1f * (seed % 4), 0.8f);
+    Positions dest = maze.getGoals();
+    if (seed % 2) dest.push_back(Position(seed % MAZE_SIZE, 0));
+    for (const auto knownOnly : {false, true}) {
+      for (const auto simple : {false, true}) {
+        stepMap.update(maze, dest, knownOnly, simple);
+        stepMapParallel.updateParallel(maze, dest, knownOnly, simple, pool);
+        EXPECT_EQ(stepMap.getMapArray(), stepMapParallel.getMapArray());
+      }
+    }
+  }
+}
+
+TEST(StepMap, setThreadPool) {
+  ThreadPool pool(2);
+  StepMap stepMap, stepMapParallel;
+  stepMapParallel.setThreadPool(&pool, 0);
+  const auto maze = randomMaze(0, 0.2f, 1.0f);
+  const auto expected =
+      stepMap.calcShortestDirections(maze, false, false);
+  EXPECT_EQ(stepMapParallel.calcShortestDirections(maze, false, false),
+            expected);
+  EXPECT_EQ(stepMap.getMapArray(), stepMapParallel.getMapArray());
+}
+
+TEST(StepMap, updateResume) {
+  StepMap stepMap, stepMapResumed;
+  for (unsigned int seed = 0; seed < 8; ++seed) {
+    const auto maze = randomMaze(seed, 0.1f * (seed % 4), 0.8f);
+    for (const auto knownOnly : {false, true}) {
+      for (const auto simple : {false, true}) {
+        stepMap.update(maze, maze.getGoals(), knownOnly, simple);
+        stepMapResumed.updateBegin(maze, maze.getGoals(), knownOnly, simple);
+        EXPECT_TRUE(stepMapResumed.isUpdating());
+        int count = 0;
+        while (!stepMapResumed.updateResume(1 + seed)) ++count;
+        EXPECT_GT(count, 0);
+        EXPECT_FALSE(stepMapResumed.isUpdating());
+        EXPECT_EQ(stepMap.getMapArray(), stepMapResumed.getMapArray());
+      }
+    }
+  }
+  /* 更新中でなければ何もしない */
+  EXPECT_TRUE(stepMapResumed.updateResume(0));
+}
+
+TEST(StepMap, getSettledStep) {
+  const auto maze = randomMaze(1, 0.2f, 0.8f);
+  StepMap stepMap, stepMapAnytime;
+  stepMap.update(maze, maze.getGoals(), false, false);
+  stepMapAnytime.updateBegin(maze, maze.getGoals(), false, false);
+  StepMap::step_t settled = 0;
+  bool done = false;
+  while (!done) {
+    done = stepMapAnytime.updateResume(16);
+    /* 確定済みの上限は単調増加し、確定済みの区画は最終値と一致する */
+    EXPECT_GE(stepMapAnytime.getSettledStep(), settled);
+    settled = stepMapAnytime.getSettledStep();
+    for (int i = 0; i < Position::SIZE; ++i) {
+      const auto p = Position::getPositionFromIndex(i);
+      if (stepMapAnytime.isSettled(p))
+        EXPECT_EQ(stepMapAnytime.getStep(p), stepMap.getStep(p));
+    }
+  }
+  EXPECT_EQ(stepMapAnytime.getSettledStep(), StepMap::STEP_MAX);
+  EXPECT_TRUE(stepMapAnytime.isSettled(maze.getStart()));
+}
+
+TEST(StepMap, getCounters) {
+#if !MAZE_STEP_MAP_COUNTERS
+  GTEST_SKIP() << "MAZE_STEP_MAP_COUNTERS is disabled";
+#endif
+  const auto maze = randomMaze(2, 0.2f, 0.8f);
+  StepMap stepMap, stepMapResumed;
+  stepMap.update(maze, maze.getGoals(), false, false);
+  const auto& c = stepMap.getCounters();
+  EXPECT_GT(c.expansions, 0);
+  EXPECT_LE(c.expansions, c.pops);
+  EXPECT_EQ(c.pops, c.pushes + int(maze.getGoals().size()));
+  EXPECT_GE(c.relaxations, c.pushes);
+  EXPECT_GT(c.queueSizeMax, 0);
+  /* 中断しても合計は同じ */
+  stepMapResumed.updateBegin(maze, maze.getGoals(), false, false);
+  while (!stepMapResumed.updateResume(10)) continue;
+  EXPECT_EQ(stepMapResumed.getCounters().pops, c.pops);
+  EXPECT_EQ(stepMapResumed.getCounters().relaxations, c.relaxations);
+}
+
+TEST(StepMap, update_position_set) {
+  const auto maze = randomMaze(3, 0.2f, 0.8f);
+  /* 多数の目的地 (重複と迷路外を含む) */
+  Positions dest;
+  for (int8_t x = 2; x < MAZE_SIZE; x += 3)
+    for (int8_t y = -1; y < MAZE_SIZE; y += 4) dest.push_back(Position(x, y));
+  dest.push_back(dest.front());
+  StepMap stepMap, stepMapSet;
+  stepMap.update(maze, dest, false, false);
+  stepMapSet.update(maze, PositionSet(dest), false, false);
+  EXPECT_EQ(stepMapSet.getMapArray(), stepMap.getMapArray());
+  EXPECT_EQ(stepMapSet.calcShortestDirections(maze, maze.getStart(),
+                                              PositionSet(dest), false, false),
+            stepMap.calcShortestDirections(maze, maze.getStart(), dest, false,
+                                           false));
+}
+
+TEST(StepMap, setSourceLabeling) {
+  const auto maze = randomMaze(4, 0.2f, 0.8f);
+  const Positions dest = {Position(1, 1), Position(12, 3), Position(6, 13),
+                          Position(MAZE_SIZE - 1, MAZE_SIZE - 1)};
+  StepMap stepMap, single;
+  stepMap.setSourceLabeling(true);
+  stepMap.update(maze, dest, false, true);
+  /* 各区画のステップは、最も近い目的地のみからのステップと一致する */
+  for (int i = 0; i < Position::SIZE; ++i) {
+    const auto p = Position::getPositionFromIndex(i);
+    const auto s = stepMap.getSource(p);
+    if (stepMap.getStep(p) == StepMap::STEP_MAX) {
+      EXPECT_EQ(s, Position(-1, -1));
+      continue;
+    }
+    ASSERT_NE(std::find(dest.cbegin(), dest.cend(), s), dest.cend());
+    single.update(maze, {s}, false, true);
+    EXPECT_EQ(single.getStep(p), stepMap.getStep(p)) << p;
+  }
+  /* 並列更新と中断可能な更新も同じ結果となる */
+  ThreadPool pool(4);
+  StepMap parallel, resumed;
+  parallel.setSourceLabeling(true);
+  resumed.setSourceLabeling(true);
+  for (const bool simple : {true, false}) {
+    stepMap.update(maze, dest, false, simple);
+    parallel.updateParallel(maze, dest, false, simple, pool);
+    resumed.updateBegin(maze, dest, false, simple);
+    while (!resumed.updateResume(10)) continue;
+    for (int i = 0; i < Position::SIZE; ++i) {
+      const auto p = Position::getPositionFromIndex(i);
+      EXPECT_EQ(parallel.getSource(p), stepMap.getSource(p));
+      EXPECT_EQ(resumed.getSource(p), stepMap.getSource(p));
+    }
+  }
+  /* 記録の領域は有効にした場合のみ確保する */
+  EXPECT_TRUE(single.getSourceArray().empty());
+  stepMap.setSourceLabeling(false);
+  EXPECT_TRUE(stepMap.getSourceArray().empty());
+  EXPECT_EQ(stepMap.getSource(dest[0]), Position(-1, -1));
+}
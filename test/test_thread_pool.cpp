@@ -0,0 +1,41 @@
+/**
+ * @file test_thread_pool.cpp
+ * @brief Unit Test for MazeLib::ThreadPool
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "MazeLib/ThreadPool.h"
+
+using namespace MazeLib;
+
+TEST(ThreadPool, parallelFor) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.size(), 4);
+  for (const int n : {0, 1, 3, 100}) {
+    std::vector<std::atomic<int>> counts(n);
+    pool.parallelFor(n, [&](const int worker, const int index) {
+      EXPECT_GE(worker, 0);
+      EXPECT_LT(worker, pool.size());
+      counts[index]++;
+    });
+    for (const auto& c : counts) EXPECT_EQ(c, 1);
+  }
+}
+
+TEST(ThreadPool, steal) {
+  ThreadPool pool(4);
+  /* 先頭のワーカーの範囲だけ重いタスクでも、全タスクが一度ずつ実行される */
+  const int n = 64;
+  std::vector<std::atomic<int>> counts(n);
+  pool.parallelFor(n, [&](const int, const int index) {
+    if (index < n / 4)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    counts[index]++;
+  });
+  for (const auto& c : counts) EXPECT_EQ(c, 1);
+}
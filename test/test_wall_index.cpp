@@ -68,3 +68,21 @@ TEST(WallIndex, operator_left_shift_left_shift) {
   ss << WallIndex(1, 2, 0);
   EXPECT_EQ(ss.str(), "(  1,  2, >)");
 }
+
+TEST(WallIndex, nextBatch) {
+  std::vector<WallIndex> src;
+  for (int8_t x = -1; x <= MAZE_SIZE; ++x)
+    for (int8_t y = -1; y <= MAZE_SIZE; ++y)
+      for (const uint8_t z : {0, 1}) src.push_back(WallIndex(x, y, z));
+  for (int8_t d = 0; d < Direction::Max; ++d) {
+    std::vector<WallIndex> dst(src.size());
+    WallIndex::nextBatch(src.data(), dst.data(), src.size(), Direction(d));
+    for (size_t i = 0; i < src.size(); ++i)
+      EXPECT_EQ(dst[i], src[i].next(Direction(d))) << src[i] << +d;
+  }
+  /* 通し番号 */
+  std::vector<uint16_t> indexes(src.size());
+  WallIndex::getIndexBatch(src.data(), indexes.data(), src.size());
+  for (size_t i = 0; i < src.size(); ++i)
+    if (src[i].isInsideOfField()) EXPECT_EQ(indexes[i], src[i].getIndex());
+}
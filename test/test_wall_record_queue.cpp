@@ -0,0 +1,66 @@
+/**
+ * @file test_wall_record_queue.cpp
+ * @brief Unit Test for MazeLib::WallRecordQueue
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "MazeLib/WallRecordQueue.h"
+
+using namespace MazeLib;
+
+TEST(WallRecordQueue, push_pop) {
+  WallRecordQueue<4> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int8_t i = 0; i < 4; ++i)
+    EXPECT_TRUE(queue.push(Position(i, 0), Direction::North, true));
+  EXPECT_FALSE(queue.push(Position(4, 0), Direction::North, true));  //< full
+  EXPECT_EQ(queue.size(), 4);
+  for (int8_t i = 0; i < 4; ++i) {
+    WallRecord wr;
+    EXPECT_TRUE(queue.pop(wr));
+    EXPECT_EQ(wr.getPosition(), Position(i, 0));
+  }
+  WallRecord wr;
+  EXPECT_FALSE(queue.pop(wr));
+}
+
+TEST(WallRecordQueue, drain) {
+  WallRecordQueue<> queue;
+  Maze maze;
+  queue.push(Position(1, 1), Direction::East, true);
+  queue.push(Position(1, 1), Direction::North, false);
+  EXPECT_FALSE(maze.isKnown(Position(1, 1), Direction::East));
+  EXPECT_EQ(queue.drain(maze), 2);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_TRUE(maze.isKnown(Position(1, 1), Direction::East));
+  EXPECT_TRUE(maze.isWall(Position(1, 1), Direction::East));
+  EXPECT_TRUE(maze.canGo(Position(1, 1), Direction::North));
+  EXPECT_EQ(maze.getWallRecords().size(), 2);
+  EXPECT_EQ(queue.drain(maze), 0);
+}
+
+TEST(WallRecordQueue, concurrent) {
+  WallRecordQueue<8> queue;
+  Maze maze;
+  const int num = MAZE_SIZE * MAZE_SIZE;
+  std::thread producer([&] {
+    for (int i = 0; i < num; ++i) {
+      const auto p = Position(i % MAZE_SIZE, i / MAZE_SIZE);
+      while (!queue.push(p, Direction::North, i % 2)) std::this_thread::yield();
+    }
+  });
+  int count = 0;
+  while (count < num) count += queue.drain(maze, false);
+  producer.join();
+  for (int i = 0; i < num; ++i) {
+    const auto p = Position(i % MAZE_SIZE, i / MAZE_SIZE);
+    if (!WallIndex(p, Direction::North).isInsideOfField()) continue;
+    EXPECT_TRUE(maze.isKnown(p, Direction::North));
+    EXPECT_EQ(maze.isWall(p, Direction::North), bool(i % 2));
+  }
+}
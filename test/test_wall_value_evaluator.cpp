@@ -0,0 +1,80 @@
+/**
+ * @file test_wall_value_evaluator.cpp
+ * @brief Unit Test for MazeLib::WallValueEvaluator
+ * @author Ryotaro Onuki <kerikun11+github@gmail.com>
+ * @date 2026-10-17
+ * @copyright Copyright 2026 Ryotaro Onuki <kerikun11+github@gmail.com>
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "MazeLib/MazeGenerator.h"
+#include "MazeLib/WallValueEvaluator.h"
+
+using namespace MazeLib;
+
+TEST(WallValueEvaluator, evaluate) {
+  /* 閉路のある既知の迷路 */
+  auto maze = MazeGenerator(1).generate(MazeGenerator::Braided, MAZE_SIZE);
+  StepMap stepMap;
+  const auto step = [&](const Maze& m, const bool knownOnly) {
+    stepMap.update(m, m.getGoals(), knownOnly, true);
+    return stepMap.getStep(m.getStart());
+  };
+  const auto shortest = step(maze, true);
+  /* 迂回路のある最短経路上の通路をひとつ未知にする */
+  const auto dirs = stepMap.calcShortestDirections(maze, true, true);
+  auto p = maze.getStart();
+  for (const auto d : dirs) {
+    const auto i = WallIndex(p, d);
+    p = p.next(d);
+    Maze m = maze;
+    m.setKnown(i, false);
+    const auto detour = step(m, true);
+    if (detour == StepMap::STEP_MAX || detour == shortest) continue;
+    maze = m;
+    break;
+  }
+  /*
+   * 既知の経路が残るよう、一部の壁を探索中と同じく未知の壁なしにする。
+   * 一部の壁は壁ありのまま未知にする (knownOnly=false でも通過不可)
+   */
+  std::mt19937 mt(1);
+  for (int i = 0; i < WallIndex::SIZE; ++i) {
+    const auto wi = WallIndex(i);
+    if (!wi.isInsideOfField() || !maze.isWall(wi)) continue;
+    const auto r = mt() % 8;
+    if (r == 0) maze.setKnown(wi, false), maze.setWall(wi, false);
+    if (r == 1) maze.setKnown(wi, false);
+  }
+  ThreadPool pool(2);
+  WallValueEvaluator evaluator(pool);
+  for (const auto knownOnly : {false, true}) {
+    /* どちらの場合も経路がある */
+    ASSERT_NE(step(maze, knownOnly), StepMap::STEP_MAX);
+    const auto results = evaluator.evaluate(maze, knownOnly, true);
+    EXPECT_FALSE(results.empty());
+    /* 最短経路上の未知の通路は、確認する価値がある */
+    EXPECT_TRUE(std::any_of(
+        results.cbegin(), results.cend(), [](const auto& r) {
+          return r.score > 0 && r.costIfWall != StepMap::STEP_MAX &&
+                 r.costIfNoWall != StepMap::STEP_MAX;
+        }));
+    /* 壁ありの未知壁は、壁なしと仮定するとコストが下がりうる */
+    EXPECT_TRUE(std::any_of(
+        results.cbegin(), results.cend(), [&](const auto& r) {
+          return maze.isWall(r.i) && r.costIfNoWall < r.costIfWall;
+        }));
+    /* すべての仮定でステップマップを更新した場合と一致する */
+    for (const auto& r : results) {
+      Maze m = maze;
+      m.setKnown(r.i, true);
+      m.setWall(r.i, true);
+      EXPECT_EQ(r.costIfWall, step(m, knownOnly));
+      m.setWall(r.i, false);
+      EXPECT_EQ(r.costIfNoWall, step(m, knownOnly));
+    }
+  }
+}